@@ -0,0 +1,399 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   Host microbenchmark for the TEC core library kernels.
+ *
+ * Measures ns per operation and operations per second of the voting and
+ * conversion kernels over several replica counts and input distributions.
+ * The kernels are the same object code the tec app links.
+ *
+ * Before timing anything the median kernels are checked against a
+ * reference sort: exhaustively (every 0-1 input and every permutation) up
+ * to TEC_CORE_NETWORK_MAX replicas, on random inputs above. The sequence
+ * tracker is checked on every gap up to past the edge of its 32 count
+ * window, across the counter wrap. The program fails if any result differs.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "tec_core.h"
+#include "tec_core_fusion.h"
+#include "tec_core_median.h"
+
+#define TEC_BENCH_DEFAULT_ITERATIONS 2000000
+#define TEC_BENCH_INPUT_SETS         256 /* power of two */
+#define TEC_BENCH_MAX_REPLICAS       31
+#define TEC_BENCH_CHECK_RANDOM_SETS  20000
+#define TEC_BENCH_TOLERANCE          1
+
+typedef TEC_Core_VoteOutcome_t (*TEC_Bench_VoteFunc_t)(const uint32_t *Values, uint32_t Count, uint32_t *Voted,
+                                                        uint32_t *AgreeMask);
+
+typedef enum
+{
+    TEC_BENCH_DIST_UNANIMOUS = 0, /* every replica reports the same value */
+    TEC_BENCH_DIST_OUTVOTED,      /* the local value is the only dissenter */
+    TEC_BENCH_DIST_MINORITY,      /* the local value holds the largest losing group */
+    TEC_BENCH_DIST_NOISE,         /* all values differ, no majority */
+    TEC_BENCH_DIST_COUNT
+} TEC_Bench_Dist_t;
+
+static const char *const TEC_Bench_DistName[TEC_BENCH_DIST_COUNT] = {"unanimous", "outvoted", "minority", "noise"};
+
+static const uint32_t TEC_Bench_ReplicaCounts[] = {3, 5, 7, 9, 15, 31};
+
+static uint32_t TEC_Bench_Inputs[TEC_BENCH_INPUT_SETS][TEC_BENCH_MAX_REPLICAS];
+
+static volatile uint32_t TEC_Bench_Sink;
+
+static uint32_t TEC_Bench_Random(void)
+{
+    static uint32_t State = 0x2545F491;
+
+    State = State * 1664525u + 1013904223u;
+    return State >> 8;
+}
+
+static double TEC_Bench_Now(void)
+{
+    struct timespec Ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &Ts);
+    return (double)Ts.tv_sec * 1e9 + (double)Ts.tv_nsec;
+}
+
+static void TEC_Bench_Generate(TEC_Bench_Dist_t Dist, uint32_t Replicas)
+{
+    uint32_t Set;
+    uint32_t i;
+    uint32_t Base;
+
+    for (Set = 0; Set < TEC_BENCH_INPUT_SETS; ++Set)
+    {
+        Base = TEC_Bench_Random() % 200;
+        for (i = 0; i < Replicas; ++i)
+        {
+            switch (Dist)
+            {
+                case TEC_BENCH_DIST_UNANIMOUS:
+                    TEC_Bench_Inputs[Set][i] = Base;
+                    break;
+                case TEC_BENCH_DIST_OUTVOTED:
+                    TEC_Bench_Inputs[Set][i] = (i == 0) ? Base + 1 : Base;
+                    break;
+                case TEC_BENCH_DIST_MINORITY:
+                    TEC_Bench_Inputs[Set][i] = (i < Replicas / 2) ? Base + 1 : Base;
+                    break;
+                default:
+                    TEC_Bench_Inputs[Set][i] = Base + i;
+                    break;
+            }
+        }
+    }
+}
+
+static TEC_Core_VoteOutcome_t TEC_Bench_MidValueVote(const uint32_t *Values, uint32_t Count, uint32_t *Voted,
+                                                     uint32_t *AgreeMask)
+{
+    return TEC_Core_MidValueVote(Values, Count, TEC_BENCH_TOLERANCE, Voted, AgreeMask);
+}
+
+static TEC_Core_VoteOutcome_t TEC_Bench_MedianVote(const uint32_t *Values, uint32_t Count, uint32_t *Voted,
+                                                   uint32_t *AgreeMask)
+{
+    return TEC_Core_MedianVote(Values, Count, TEC_BENCH_TOLERANCE, Voted, AgreeMask);
+}
+
+static TEC_Core_VoteOutcome_t TEC_Bench_ToleranceMajorityVote(const uint32_t *Values, uint32_t Count,
+                                                              uint32_t *Voted, uint32_t *AgreeMask)
+{
+    return TEC_Core_ToleranceMajorityVote(Values, Count, TEC_BENCH_TOLERANCE, Voted, AgreeMask);
+}
+
+static TEC_Core_VoteOutcome_t TEC_Bench_WeightedAverageVote(const uint32_t *Values, uint32_t Count, uint32_t *Voted,
+                                                            uint32_t *AgreeMask)
+{
+    static const uint32_t Weights[TEC_CORE_SORT_MAX] = {
+        1, 2, 3, 4, 1, 2, 3, 4, 1, 2, 3, 4, 1, 2, 3, 4, 1, 2, 3, 4, 1, 2, 3, 4, 1, 2, 3, 4, 1, 2, 3, 4};
+
+    return TEC_Core_WeightedAverageVote(Values, Weights, Count, TEC_BENCH_TOLERANCE, Voted, AgreeMask);
+}
+
+static const struct
+{
+    const char          *Name;
+    TEC_Bench_VoteFunc_t Func;
+} TEC_Bench_Voters[] = {
+    {"vote", TEC_Core_MajorityVote},
+    {"mvs", TEC_Bench_MidValueVote},
+    {"median", TEC_Bench_MedianVote},
+    {"tolmaj", TEC_Bench_ToleranceMajorityVote},
+    {"wavg", TEC_Bench_WeightedAverageVote},
+};
+
+static int TEC_Bench_CompareU32(const void *A, const void *B)
+{
+    uint32_t X = *(const uint32_t *)A;
+    uint32_t Y = *(const uint32_t *)B;
+
+    return (X > Y) - (X < Y);
+}
+
+/* Compare both median kernels with qsort on one input, 0 if they agree */
+static int TEC_Bench_CheckOne(const uint32_t *Values, uint32_t Count)
+{
+    uint32_t Sorted[TEC_CORE_SORT_MAX];
+    uint32_t Network[TEC_CORE_SORT_MAX];
+    uint32_t Lo;
+    uint32_t Hi;
+
+    memcpy(Sorted, Values, Count * sizeof(Sorted[0]));
+    memcpy(Network, Values, Count * sizeof(Network[0]));
+    qsort(Sorted, Count, sizeof(Sorted[0]), TEC_Bench_CompareU32);
+    TEC_Core_SortNetwork(Network, Count);
+
+    Lo = Sorted[(Count - 1) / 2];
+    Hi = Sorted[Count / 2];
+
+    if (memcmp(Sorted, Network, Count * sizeof(Sorted[0])) != 0 || TEC_Core_MidValueSelect(Values, Count) != Lo ||
+        TEC_Core_Median(Values, Count) != (uint32_t)(((uint64_t)Lo + Hi) / 2))
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+/* Visit every permutation of Values[First..Count-1] by recursive swapping */
+static unsigned long TEC_Bench_CheckPermutations(uint32_t *Values, uint32_t Count, uint32_t First)
+{
+    unsigned long Failures = 0;
+    uint32_t      Tmp;
+    uint32_t      i;
+
+    if (First + 1 >= Count)
+    {
+        return (unsigned long)TEC_Bench_CheckOne(Values, Count);
+    }
+
+    for (i = First; i < Count; ++i)
+    {
+        Tmp           = Values[First];
+        Values[First] = Values[i];
+        Values[i]     = Tmp;
+        Failures += TEC_Bench_CheckPermutations(Values, Count, First + 1);
+        Tmp           = Values[First];
+        Values[First] = Values[i];
+        Values[i]     = Tmp;
+    }
+
+    return Failures;
+}
+
+static int TEC_Bench_CheckMedian(void)
+{
+    uint32_t      Values[TEC_CORE_SORT_MAX];
+    unsigned long Cases    = 0;
+    unsigned long Failures = 0;
+    uint32_t      Count;
+    uint32_t      Bits;
+    uint32_t      Set;
+    uint32_t      i;
+
+    for (Count = 1; Count <= TEC_CORE_NETWORK_MAX; ++Count)
+    {
+        /* 0-1 principle: a comparator network that sorts every 0-1 input sorts every input */
+        for (Bits = 0; Bits < (1U << Count); ++Bits)
+        {
+            for (i = 0; i < Count; ++i)
+            {
+                Values[i] = ((Bits >> i) & 1) ? 0xFFFFFFFFU : 0;
+            }
+            Failures += (unsigned long)TEC_Bench_CheckOne(Values, Count);
+            ++Cases;
+        }
+
+        for (i = 0; i < Count; ++i)
+        {
+            Values[i] = i * 1000U;
+        }
+        Failures += TEC_Bench_CheckPermutations(Values, Count, 0);
+        for (Bits = 1, i = 2; i <= Count; ++i)
+        {
+            Bits *= i;
+        }
+        Cases += Bits;
+    }
+
+    for (Count = TEC_CORE_NETWORK_MAX + 1; Count <= TEC_CORE_SORT_MAX; ++Count)
+    {
+        for (Set = 0; Set < TEC_BENCH_CHECK_RANDOM_SETS; ++Set)
+        {
+            for (i = 0; i < Count; ++i)
+            {
+                Values[i] = TEC_Bench_Random() % 64;
+            }
+            Failures += (unsigned long)TEC_Bench_CheckOne(Values, Count);
+            ++Cases;
+        }
+    }
+
+    printf("median check: %lu cases, %lu mismatches\n", Cases, Failures);
+
+    return Failures == 0;
+}
+
+/* Gaps around the 32 count window: which counts come back late, which are duplicates */
+static int TEC_Bench_CheckSequence(void)
+{
+    TEC_Core_SeqTracker_t Tracker;
+    TEC_Core_SeqClass_t   Expect;
+    unsigned long         Cases    = 0;
+    unsigned long         Failures = 0;
+    uint32_t              Missed;
+    uint32_t              Step;
+    uint32_t              k;
+    uint16_t              Last = TEC_CORE_SEQ_MODULUS - 3; /* Gaps cross the wrap */
+
+#define TEC_BENCH_SEQ(Offset) ((uint16_t)((Last + (Offset)) & (TEC_CORE_SEQ_MODULUS - 1)))
+
+    for (Step = 1; Step <= 40; ++Step)
+    {
+        memset(&Tracker, 0, sizeof(Tracker));
+        TEC_Core_SequenceTrack(&Tracker, Last, &Missed);
+
+        Expect = (Step == 1) ? TEC_CORE_SEQ_NEXT : TEC_CORE_SEQ_GAP;
+        Failures += (TEC_Core_SequenceTrack(&Tracker, TEC_BENCH_SEQ(Step), &Missed) != Expect || Missed != Step - 1);
+        ++Cases;
+
+        /* Every skipped count still in the window is late once, then a duplicate */
+        for (k = (Step > 32) ? Step - 32 : 1; k < Step; ++k)
+        {
+            Failures += (TEC_Core_SequenceTrack(&Tracker, TEC_BENCH_SEQ(k), &Missed) != TEC_CORE_SEQ_LATE);
+            Failures += (TEC_Core_SequenceTrack(&Tracker, TEC_BENCH_SEQ(k), &Missed) != TEC_CORE_SEQ_DUPLICATE);
+            Cases += 2;
+        }
+
+        /* The old newest count was received: a duplicate while in the window, a restart past it */
+        Expect = (Step <= 32) ? TEC_CORE_SEQ_DUPLICATE : TEC_CORE_SEQ_NEXT;
+        Failures += (TEC_Core_SequenceTrack(&Tracker, Last, &Missed) != Expect);
+        ++Cases;
+    }
+
+#undef TEC_BENCH_SEQ
+
+    printf("sequence check: %lu cases, %lu mismatches\n", Cases, Failures);
+
+    return Failures == 0;
+}
+
+static void TEC_Bench_Vote(uint32_t Voter, uint32_t Replicas, TEC_Bench_Dist_t Dist, unsigned long Iterations)
+{
+    TEC_Bench_VoteFunc_t Func = TEC_Bench_Voters[Voter].Func;
+
+    unsigned long n;
+    uint32_t      Voted = 0;
+    uint32_t      Mask  = 0;
+    uint32_t      Outcomes = 0;
+    double        Start;
+    double        Elapsed;
+
+    TEC_Bench_Generate(Dist, Replicas);
+
+    Start = TEC_Bench_Now();
+    for (n = 0; n < Iterations; ++n)
+    {
+        Outcomes += (uint32_t)Func(TEC_Bench_Inputs[n & (TEC_BENCH_INPUT_SETS - 1)], Replicas, &Voted, &Mask);
+    }
+    Elapsed = TEC_Bench_Now() - Start;
+
+    TEC_Bench_Sink = Voted + Outcomes + Mask;
+
+    printf("%-8s %8u  %-10s  %10.2f  %14.0f\n", TEC_Bench_Voters[Voter].Name, (unsigned int)Replicas, TEC_Bench_DistName[Dist],
+           Elapsed / (double)Iterations, (double)Iterations * 1e9 / Elapsed);
+}
+
+static void TEC_Bench_Convert(char Unit, unsigned long Iterations)
+{
+    unsigned long n;
+    uint32_t      Converted = 0;
+    uint32_t      Sum       = 0;
+    double        Start;
+    double        Elapsed;
+
+    Start = TEC_Bench_Now();
+    for (n = 0; n < Iterations; ++n)
+    {
+        TEC_Core_ConvertTemperature(TEC_Core_ReadRawSensor() + (uint32_t)(n & 0x7F), Unit, &Converted);
+        Sum += Converted;
+    }
+    Elapsed = TEC_Bench_Now() - Start;
+
+    TEC_Bench_Sink = Sum;
+
+    printf("%-8s %8s  %-10c  %10.2f  %14.0f\n", "convert", "-", Unit, Elapsed / (double)Iterations,
+           (double)Iterations * 1e9 / Elapsed);
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned long Iterations = TEC_BENCH_DEFAULT_ITERATIONS;
+    uint32_t      v;
+    uint32_t      r;
+    int           d;
+
+    if (argc > 1)
+    {
+        Iterations = strtoul(argv[1], NULL, 0);
+        if (Iterations == 0)
+        {
+            fprintf(stderr, "usage: %s [iterations]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (!TEC_Bench_CheckMedian() || !TEC_Bench_CheckSequence())
+    {
+        return EXIT_FAILURE;
+    }
+
+    printf("%-8s %8s  %-10s  %10s  %14s\n", "kernel", "replicas", "input", "ns/op", "ops/s");
+
+    TEC_Bench_Convert(TEC_CORE_UNIT_CELSIUS, Iterations);
+    TEC_Bench_Convert(TEC_CORE_UNIT_FAHRENHEIT, Iterations);
+
+    for (v = 0; v < sizeof(TEC_Bench_Voters) / sizeof(TEC_Bench_Voters[0]); ++v)
+    {
+        for (r = 0; r < sizeof(TEC_Bench_ReplicaCounts) / sizeof(TEC_Bench_ReplicaCounts[0]); ++r)
+        {
+            for (d = 0; d < TEC_BENCH_DIST_COUNT; ++d)
+            {
+                TEC_Bench_Vote(v, TEC_Bench_ReplicaCounts[r], (TEC_Bench_Dist_t)d, Iterations);
+            }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,468 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   Host replay driver for TEC software bus captures.
+ *
+ * Loads a capture written by TEC_CAPTURE_START_CC into memory and plays it
+ * back, either as fast as possible or at the recorded pacing. The capture
+ * holds the vote state at its start, every local sample, every voter pass
+ * and every message; replica exchange packets, samples and passes go
+ * through the same tec_core_voter.h calls as in the TEC app, so the votes
+ * come out as they did on the node. Ground commands, housekeeping requests
+ * and state transfer need cFE services and are only classified and
+ * counted; their effect on the vote is in the state records that follow.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "tec_capture_fmt.h"
+#include "tec_core.h"
+#include "tec_core_voter.h"
+
+#define TEC_REPLAY_DEFAULT_HDR_SIZE 16 /* TelemetryHeader, the exchange payload follows */
+
+typedef enum
+{
+    TEC_REPLAY_PATH_CMD = 0,
+    TEC_REPLAY_PATH_SEND_HK,
+    TEC_REPLAY_PATH_WAKEUP,
+    TEC_REPLAY_PATH_STATE_REQ,
+    TEC_REPLAY_PATH_STATE_RSP,
+    TEC_REPLAY_PATH_REPLICA,
+    TEC_REPLAY_PATH_UNKNOWN,
+    TEC_REPLAY_PATH_COUNT
+} TEC_Replay_Path_t;
+
+static const char *const TEC_Replay_PathName[TEC_REPLAY_PATH_COUNT] = {
+    "CMD", "SEND_HK", "WAKEUP", "STATE_REQ", "STATE_RSP", "REPLICA", "unknown"};
+
+typedef struct
+{
+    uint32_t HdrSize;
+    uint32_t Repeat;
+    int      Paced;
+} TEC_Replay_Options_t;
+
+typedef struct
+{
+    TEC_Core_Voter_t Voter;
+    bool             HaveVoter;                      /* A vote state record has been loaded */
+    bool             BigEndian;                      /* Message payloads are big endian, from the file header */
+    uint32_t         MsgId[TEC_REPLAY_PATH_REPLICA]; /* Message ID of each fixed path, from the file header */
+    uint32_t         PathCount[TEC_REPLAY_PATH_COUNT];
+    uint32_t         Outcome[3];
+    uint32_t         LocalLost;
+    uint32_t         Masked;
+    uint32_t         Reintegrated;
+    uint32_t         StateRecords;
+    uint32_t         Skipped;
+    uint32_t         Truncated;
+} TEC_Replay_State_t;
+
+static TEC_Replay_State_t TEC_Replay_State;
+
+static double TEC_Replay_Now(void)
+{
+    struct timespec Ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &Ts);
+    return (double)Ts.tv_sec * 1e9 + (double)Ts.tv_nsec;
+}
+
+static uint32_t TEC_Replay_PopCount(uint32_t Mask)
+{
+    uint32_t Count = 0;
+
+    while (Mask != 0)
+    {
+        Mask &= Mask - 1;
+        ++Count;
+    }
+
+    return Count;
+}
+
+/*
+** Same steps as TEC_MajorityVoter
+*/
+static void TEC_Replay_Tick(const TEC_CaptureTick_t *Tick)
+{
+    TEC_Core_Voter_t     *Voter = &TEC_Replay_State.Voter;
+    TEC_Core_EpochSlot_t  Slot;
+    TEC_Core_VoteReport_t Report;
+    uint32_t              Masked;
+    uint32_t              Reintegrated;
+    uint32_t              Seen;
+
+    TEC_Core_VoterLocalHealthy(Voter, Tick->LocalHealthy != 0);
+
+    while (TEC_Core_VoterNext(Voter, Tick->Now, &Slot))
+    {
+        if (TEC_Core_VoterVote(Voter, &Slot, &Report))
+        {
+            ++TEC_Replay_State.Outcome[Report.Outcome];
+            TEC_Replay_State.LocalLost += Report.LocalLost;
+        }
+    }
+
+    if (TEC_Core_VoterHealthUpdate(Voter, Tick->Now, &Masked, &Reintegrated, &Seen))
+    {
+        TEC_Replay_State.Masked += TEC_Replay_PopCount(Masked);
+        TEC_Replay_State.Reintegrated += TEC_Replay_PopCount(Reintegrated);
+    }
+}
+
+/*
+** Message payload field in the byte order of the node that wrote the capture
+*/
+static uint32_t TEC_Replay_Get32(const uint8_t *Field)
+{
+    if (TEC_Replay_State.BigEndian)
+    {
+        return ((uint32_t)Field[0] << 24) | ((uint32_t)Field[1] << 16) | ((uint32_t)Field[2] << 8) | Field[3];
+    }
+
+    return ((uint32_t)Field[3] << 24) | ((uint32_t)Field[2] << 16) | ((uint32_t)Field[1] << 8) | Field[0];
+}
+
+/*
+** Same steps as TEC_ReplicaReceive
+*/
+static void TEC_Replay_Replica(const uint8_t *Msg, uint32_t Size, uint8_t Replica, const TEC_Replay_Options_t *Opt)
+{
+    TEC_Core_ExchangeSample_t Sample;
+    const uint8_t            *Payload = Msg + Opt->HdrSize;
+    uint16_t                  SeqCnt;
+    uint32_t                  Missed;
+
+    if (Size < Opt->HdrSize + sizeof(Sample))
+    {
+        ++TEC_Replay_State.Truncated;
+        return;
+    }
+
+    /* CCSDS primary header sequence count, big endian, 14 bits */
+    SeqCnt = (uint16_t)(((Msg[2] << 8) | Msg[3]) & (TEC_CORE_SEQ_MODULUS - 1));
+    memset(&Sample, 0, sizeof(Sample));
+    Sample.Epoch       = TEC_Replay_Get32(Payload + offsetof(TEC_Core_ExchangeSample_t, Epoch));
+    Sample.Raw         = TEC_Replay_Get32(Payload + offsetof(TEC_Core_ExchangeSample_t, Raw));
+    Sample.Quality     = Payload[offsetof(TEC_Core_ExchangeSample_t, Quality)];
+    Sample.ChangedMask = Payload[offsetof(TEC_Core_ExchangeSample_t, ChangedMask)];
+
+    TEC_Core_VoterRemote(&TEC_Replay_State.Voter, Replica, SeqCnt, &Sample, &Missed);
+}
+
+/*
+** Classifies a message like the MsgId switch of TEC_TaskPipe
+*/
+static void TEC_Replay_Message(const uint8_t *Msg, uint32_t Size, const TEC_Replay_Options_t *Opt)
+{
+    uint16_t MsgId;
+    uint8_t  Replica;
+    uint32_t Path;
+
+    if (Size < 6)
+    {
+        ++TEC_Replay_State.Truncated;
+        return;
+    }
+
+    /* CCSDS primary header stream ID, big endian */
+    MsgId = (uint16_t)((Msg[0] << 8) | Msg[1]);
+
+    for (Path = 0; Path < TEC_REPLAY_PATH_REPLICA; ++Path)
+    {
+        if (MsgId == TEC_Replay_State.MsgId[Path])
+        {
+            ++TEC_Replay_State.PathCount[Path];
+            return;
+        }
+    }
+
+    if (TEC_Core_VoterLookup(&TEC_Replay_State.Voter, MsgId, &Replica))
+    {
+        ++TEC_Replay_State.PathCount[TEC_REPLAY_PATH_REPLICA];
+        TEC_Replay_Replica(Msg, Size, Replica, Opt);
+    }
+    else
+    {
+        ++TEC_Replay_State.PathCount[TEC_REPLAY_PATH_UNKNOWN];
+    }
+}
+
+static void TEC_Replay_Record(const TEC_CaptureRecordHdr_t *RecordHdr, const uint8_t *Data,
+                              const TEC_Replay_Options_t *Opt)
+{
+    TEC_CaptureVoter_t  Voter;
+    TEC_CaptureSample_t Sample;
+    TEC_CaptureTick_t   Tick;
+
+    if (RecordHdr->Type == TEC_CAPTURE_RECORD_VOTER)
+    {
+        if (RecordHdr->Size != sizeof(Voter))
+        {
+            ++TEC_Replay_State.Truncated;
+            return;
+        }
+
+        memcpy(&Voter, Data, sizeof(Voter));
+        TEC_Replay_State.HaveVoter = TEC_Core_CaptureVoterLoad(&TEC_Replay_State.Voter, &Voter);
+        ++TEC_Replay_State.StateRecords;
+        return;
+    }
+
+    /* Nothing can be voted on before the state the capture started from */
+    if (!TEC_Replay_State.HaveVoter)
+    {
+        ++TEC_Replay_State.Skipped;
+        return;
+    }
+
+    switch (RecordHdr->Type)
+    {
+        case TEC_CAPTURE_RECORD_MSG:
+            TEC_Replay_Message(Data, RecordHdr->Size, Opt);
+            break;
+
+        case TEC_CAPTURE_RECORD_SAMPLE:
+            if (RecordHdr->Size != sizeof(Sample))
+            {
+                ++TEC_Replay_State.Truncated;
+                break;
+            }
+            memcpy(&Sample, Data, sizeof(Sample));
+            TEC_Core_VoterLocal(&TEC_Replay_State.Voter, TEC_Core_CaptureLE32(Sample.Epoch),
+                                TEC_Core_CaptureLE32(Sample.Raw));
+            break;
+
+        case TEC_CAPTURE_RECORD_TICK:
+            if (RecordHdr->Size != sizeof(Tick))
+            {
+                ++TEC_Replay_State.Truncated;
+                break;
+            }
+            memcpy(&Tick, Data, sizeof(Tick));
+            Tick.Now          = TEC_Core_CaptureLE32(Tick.Now);
+            Tick.LocalHealthy = TEC_Core_CaptureLE32(Tick.LocalHealthy);
+            TEC_Replay_Tick(&Tick);
+            break;
+
+        default:
+            ++TEC_Replay_State.Skipped;
+            break;
+    }
+}
+
+static uint8_t *TEC_Replay_Load(const char *Filename, size_t *Length)
+{
+    FILE                *File;
+    uint8_t             *Data;
+    long                 FileSize;
+    TEC_CaptureFileHdr_t FileHdr;
+
+    File = fopen(Filename, "rb");
+    if (File == NULL)
+    {
+        perror(Filename);
+        return NULL;
+    }
+
+    if (fread(&FileHdr, sizeof(FileHdr), 1, File) != 1 || TEC_Core_CaptureLE32(FileHdr.Magic) != TEC_CAPTURE_MAGIC ||
+        TEC_Core_CaptureLE32(FileHdr.Version) != TEC_CAPTURE_VERSION)
+    {
+        fprintf(stderr, "%s: not a TEC capture file (version %d)\n", Filename, TEC_CAPTURE_VERSION);
+        fclose(File);
+        return NULL;
+    }
+
+    TEC_Replay_State.BigEndian = (TEC_Core_CaptureLE32(FileHdr.Flags) & TEC_CAPTURE_FLAG_BIG_ENDIAN) != 0;
+
+    TEC_Replay_State.MsgId[TEC_REPLAY_PATH_CMD]       = TEC_Core_CaptureLE32(FileHdr.CmdMsgId);
+    TEC_Replay_State.MsgId[TEC_REPLAY_PATH_SEND_HK]   = TEC_Core_CaptureLE32(FileHdr.SendHkMsgId);
+    TEC_Replay_State.MsgId[TEC_REPLAY_PATH_WAKEUP]    = TEC_Core_CaptureLE32(FileHdr.WakeupMsgId);
+    TEC_Replay_State.MsgId[TEC_REPLAY_PATH_STATE_REQ] = TEC_Core_CaptureLE32(FileHdr.StateReqMsgId);
+    TEC_Replay_State.MsgId[TEC_REPLAY_PATH_STATE_RSP] = TEC_Core_CaptureLE32(FileHdr.StateRspMsgId);
+
+    fseek(File, 0, SEEK_END);
+    FileSize = ftell(File) - (long)sizeof(FileHdr);
+    fseek(File, (long)sizeof(FileHdr), SEEK_SET);
+
+    Data = malloc(FileSize > 0 ? (size_t)FileSize : 1);
+    if (Data == NULL || fread(Data, 1, (size_t)FileSize, File) != (size_t)FileSize)
+    {
+        fprintf(stderr, "%s: read error\n", Filename);
+        free(Data);
+        fclose(File);
+        return NULL;
+    }
+
+    fclose(File);
+    *Length = (size_t)FileSize;
+    return Data;
+}
+
+static void TEC_Replay_SleepUntil(double Deadline)
+{
+    struct timespec Ts;
+    double          Delay = Deadline - TEC_Replay_Now();
+
+    if (Delay > 0)
+    {
+        Ts.tv_sec  = (time_t)(Delay / 1e9);
+        Ts.tv_nsec = (long)(Delay - (double)Ts.tv_sec * 1e9);
+        nanosleep(&Ts, NULL);
+    }
+}
+
+static void TEC_Replay_Usage(const char *Prog)
+{
+    fprintf(stderr,
+            "usage: %s [-p] [-r repeat] [-o header_size] capture_file\n"
+            "  -p  replay at the recorded pacing instead of as fast as possible\n",
+            Prog);
+}
+
+int main(int argc, char *argv[])
+{
+    TEC_Replay_Options_t   Opt = {TEC_REPLAY_DEFAULT_HDR_SIZE, 1, 0};
+    TEC_CaptureRecordHdr_t RecordHdr;
+    uint8_t               *Data;
+    size_t                 Length = 0;
+    size_t                 Pos;
+    uint32_t               Pass;
+    uint32_t               Records = 0;
+    double                 FirstRecorded;
+    double                 Recorded;
+    double                 Start;
+    double                 Elapsed;
+    int                    Ch;
+    int                    i;
+
+    while ((Ch = getopt(argc, argv, "pr:o:")) != -1)
+    {
+        switch (Ch)
+        {
+            case 'p':
+                Opt.Paced = 1;
+                break;
+            case 'r':
+                Opt.Repeat = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'o':
+                Opt.HdrSize = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            default:
+                TEC_Replay_Usage(argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if (optind != argc - 1 || Opt.Repeat == 0)
+    {
+        TEC_Replay_Usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    Data = TEC_Replay_Load(argv[optind], &Length);
+    if (Data == NULL)
+    {
+        return EXIT_FAILURE;
+    }
+
+    Start = TEC_Replay_Now();
+    for (Pass = 0; Pass < Opt.Repeat; ++Pass)
+    {
+        double PassStart = TEC_Replay_Now();
+
+        FirstRecorded = -1;
+        for (Pos = 0; Pos + sizeof(RecordHdr) <= Length; Pos += sizeof(RecordHdr) + RecordHdr.Size)
+        {
+            memcpy(&RecordHdr, Data + Pos, sizeof(RecordHdr));
+            RecordHdr.Seconds     = TEC_Core_CaptureLE32(RecordHdr.Seconds);
+            RecordHdr.Nanoseconds = TEC_Core_CaptureLE32(RecordHdr.Nanoseconds);
+            RecordHdr.Size        = TEC_Core_CaptureLE32(RecordHdr.Size);
+            RecordHdr.Type        = TEC_Core_CaptureLE32(RecordHdr.Type);
+            if (Pos + sizeof(RecordHdr) + RecordHdr.Size > Length)
+            {
+                ++TEC_Replay_State.Truncated;
+                break;
+            }
+
+            if (Opt.Paced)
+            {
+                Recorded = (double)RecordHdr.Seconds * 1e9 + (double)RecordHdr.Nanoseconds;
+                if (FirstRecorded < 0)
+                {
+                    FirstRecorded = Recorded;
+                }
+                TEC_Replay_SleepUntil(PassStart + (Recorded - FirstRecorded));
+            }
+
+            TEC_Replay_Record(&RecordHdr, Data + Pos + sizeof(RecordHdr), &Opt);
+            ++Records;
+        }
+    }
+    Elapsed = TEC_Replay_Now() - Start;
+
+    free(Data);
+
+    printf("records   %lu in %.3f ms, %.1f ns/record, %.0f records/s%s\n", (unsigned long)Records, Elapsed / 1e6,
+           Records ? Elapsed / (double)Records : 0.0, Elapsed > 0 ? (double)Records * 1e9 / Elapsed : 0.0,
+           Opt.Paced ? " (paced)" : "");
+    for (i = 0; i < TEC_REPLAY_PATH_COUNT; ++i)
+    {
+        printf("%-9s %lu\n", TEC_Replay_PathName[i], (unsigned long)TEC_Replay_State.PathCount[i]);
+    }
+    printf("state     %lu records\n", (unsigned long)TEC_Replay_State.StateRecords);
+    printf("votes     agreed %lu, outvoted %lu, no majority %lu, local lost %lu\n",
+           (unsigned long)TEC_Replay_State.Outcome[TEC_CORE_VOTE_AGREED],
+           (unsigned long)TEC_Replay_State.Outcome[TEC_CORE_VOTE_OUTVOTED],
+           (unsigned long)TEC_Replay_State.Outcome[TEC_CORE_VOTE_NO_MAJORITY],
+           (unsigned long)TEC_Replay_State.LocalLost);
+    printf("last vote %lu at epoch %lu%s, agree 0x%08lx, active 0x%08lx\n",
+           (unsigned long)TEC_Replay_State.Voter.Temperature, (unsigned long)TEC_Replay_State.Voter.VotedEpoch,
+           TEC_Replay_State.Voter.VoteValid ? "" : " (invalid)", (unsigned long)TEC_Replay_State.Voter.AgreeMask,
+           (unsigned long)TEC_Replay_State.Voter.Health.Active);
+    printf("epochs    voted %lu, incomplete %lu, late samples %lu, evicted %lu, superseded %lu\n",
+           (unsigned long)TEC_Replay_State.Voter.Stats.EpochsVoted,
+           (unsigned long)TEC_Replay_State.Voter.Stats.EpochsIncomplete,
+           (unsigned long)TEC_Replay_State.Voter.Stats.EpochSamplesLate,
+           (unsigned long)TEC_Replay_State.Voter.Stats.EpochsEvicted,
+           (unsigned long)TEC_Replay_State.Voter.Stats.ReplicaSuperseded);
+    printf("health    masked %lu, reintegrated %lu\n", (unsigned long)TEC_Replay_State.Masked,
+           (unsigned long)TEC_Replay_State.Reintegrated);
+    if (TEC_Replay_State.Skipped)
+    {
+        printf("skipped   %lu\n", (unsigned long)TEC_Replay_State.Skipped);
+    }
+    if (TEC_Replay_State.Truncated)
+    {
+        printf("truncated %lu\n", (unsigned long)TEC_Replay_State.Truncated);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -40,6 +40,10 @@
 #define TEC_PROCESS_CC          2
 #define TEC_DISPLAY_PARAM_CC    3
 #define TEC_GET_TEMPERATURE_CC  4
+#define TEC_RESET_DIAG_CC       5
+#define TEC_SELF_BENCH_CC       6
+#define TEC_CAPTURE_START_CC    7
+#define TEC_CAPTURE_STOP_CC     8
 
 
 #endif
@@ -41,4 +41,88 @@
  */
 #define TEC_STRING_VAL_LEN 10
 
+/**
+ * \brief Number of buckets in each latency histogram of the diagnostics packet
+ *
+ * Bucket n counts latencies in [2^n, 2^(n+1)) nanoseconds, bucket 0 also
+ * takes 0 ns and the last bucket is open ended (>= 8.4 ms with 24 buckets).
+ */
+#define TEC_LATENCY_HIST_BUCKETS 24
+
+/**
+ * \brief Length of the file name in the Capture Start command
+ */
+#define TEC_CAPTURE_FILENAME_LEN 64
+
+/**
+ * \brief Largest number of remote replicas in the configuration table
+ *
+ * The local node plus every remote replica must fit one 32 bit mask.
+ */
+#define TEC_MAX_REPLICAS 31
+
+/**
+ * \brief Largest number of voters: the local node plus every remote replica
+ */
+#define TEC_MAX_VOTERS 32
+
+/**
+ * \brief Sampling modes selectable in the configuration table
+ *
+ * Free running samples every SamplePeriodMsec from whenever the task
+ * started. Time aligned samples on a grid of SamplePeriodMsec offset by
+ * SamplePhaseMsec in cFE time, which the time tone keeps common to all
+ * nodes, so every replica samples at the same instants.
+ */
+#define TEC_SAMPLE_MODE_FREE_RUN     0
+#define TEC_SAMPLE_MODE_TIME_ALIGNED 1
+#define TEC_SAMPLE_MODE_COUNT        2
+
+/**
+ * \brief Voting modes selectable in the configuration table
+ *
+ * Exact majority needs more than half of the values to be identical. Mid-value
+ * select and median order the values and take the middle one (for an even
+ * count the lower middle value, or the mean of both middle values); more
+ * than half of the values must then lie within VoteTolerance of it. Tolerance
+ * majority treats values within VoteTolerance of each other as equal.
+ * Weighted average takes the mean weighted by VoteWeight. First healthy
+ * takes the first voter, local node first, with a usable value.
+ */
+#define TEC_VOTE_MODE_MAJORITY           0
+#define TEC_VOTE_MODE_MID_VALUE          1
+#define TEC_VOTE_MODE_MEDIAN             2
+#define TEC_VOTE_MODE_TOLERANCE_MAJORITY 3
+#define TEC_VOTE_MODE_WEIGHTED_AVERAGE   4
+#define TEC_VOTE_MODE_FIRST_HEALTHY      5
+#define TEC_VOTE_MODE_COUNT              6
+
+/**
+ * \brief Largest weight of one voter in the weighted average mode
+ */
+#define TEC_VOTE_WEIGHT_MAX 0xFFFF
+
+/**
+ * \brief Replica exchange transports selectable in the configuration table
+ *
+ * The software bus reaches the other nodes through the mission's bridge.
+ * UDP sends the exchange packets straight to every peer in UdpPeer,
+ * UdpBatch packets to a datagram, and falls back to the software bus if
+ * the socket cannot be set up. Packets from the other replicas are
+ * accepted from either transport.
+ */
+#define TEC_TRANSPORT_SB    0
+#define TEC_TRANSPORT_UDP   1
+#define TEC_TRANSPORT_COUNT 2
+
+/**
+ * \brief Length of a dotted IPv4 address in the configuration table, including the terminator
+ */
+#define TEC_UDP_ADDRESS_LEN 16
+
+/**
+ * \brief Most exchange packets carried by one UDP datagram
+ */
+#define TEC_UDP_BATCH_MAX 4
+
 #endif
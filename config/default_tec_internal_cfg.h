@@ -33,12 +33,107 @@
 #define TEC_INTERNAL_CFG_H
 
 /***********************************************************************/
-#define TEC_PIPE_DEPTH 32 /* Depth of the Command Pipe for Application */
+#define TEC_PIPE_DEPTH 16 /* Depth of the Command Pipe for Application */
 
-#define TEC_NUMBER_OF_TABLES 1 /* Number of Example Table(s) */
+/*
+** Replica telemetry arrives on its own pipe so a burst of it cannot crowd
+** out or delay ground commands. The per-MID limits cap how many packets of
+** one message ID each pipe may hold; SB drops the excess at the sender.
+*/
+#define TEC_REPLICA_PIPE_NAME  "TEC_RPL_PIPE"
+#define TEC_REPLICA_PIPE_DEPTH 32
+#define TEC_CMD_MSG_LIM        8
+#define TEC_SEND_HK_MSG_LIM    2
+#define TEC_WAKEUP_MSG_LIM     2
+#define TEC_REPLICA_MSG_LIM    8
+#define TEC_STATE_MSG_LIM      4
+
+/*
+** Replica packets only overwrite the newest value of their processor and the
+** vote runs once afterwards, so the replica pipe is drained in one pass.
+*/
+#define TEC_REPLICA_BATCH_MAX TEC_REPLICA_PIPE_DEPTH
+
+#define TEC_MAX_SUBSCRIPTIONS 8 /* Entries in the subscription table in tec_pipes.c */
+
+/*
+** Messages handled per runloop wakeup. After the pending receive returns,
+** up to TEC_RX_BATCH_MAX - 1 more queued messages are taken with polling
+** receives; the sensor is sampled once and the vote runs once per batch.
+*/
+#define TEC_RX_BATCH_MAX 8
+
+/*
+** Longest time the main task pends on its pipe, in milliseconds.
+** The scheduler wakeup (TEC_WAKEUP_MID) normally arrives first; this only
+** bounds how long periodic work can be held off when the bus goes silent.
+*/
+#define TEC_RX_TIMEOUT_MSEC 500
+
+#define TEC_NUMBER_OF_TABLES 2 /* Number of Table(s) */
+
+#define TEC_EXAMPLE_TBL_IDX 0 /* Index of the Example Table in TblHandles */
+#define TEC_CONFIG_TBL_IDX  1 /* Index of the Configuration Table in TblHandles */
 
 #define TEC_TABLE_OUT_OF_RANGE_ERR_CODE -1
 
 #define TEC_TBL_ELEMENT_1_MAX 10
 
+/*
+** Sampling child task
+*/
+#define TEC_SAMPLE_TASK_NAME       "TEC_SAMPLER"
+#define TEC_SAMPLE_TASK_STACK_SIZE 8192
+#define TEC_SAMPLE_TASK_PRIORITY   40 /* Above the TEC main task so sampling is not held off */
+#define TEC_SAMPLE_MUTEX_NAME      "TEC_SAMPLE_MTX"
+#define TEC_SAMPLE_PERIOD_MIN_MSEC 10
+#define TEC_SAMPLE_PERIOD_MAX_MSEC 60000
+
+/*
+** Epoch-aligned voting: one epoch is one sample period. An epoch is voted
+** on once every voter has reported for it, or once it is this many epochs
+** old; it must cover the transport delay of the replica values and the
+** wakeup period. Fewer values than TEC_VOTE_MIN_VOTERS are not voted on.
+*/
+#define TEC_VOTE_DEADLINE_EPOCHS 8
+#define TEC_VOTE_MIN_VOTERS      2
+
+/*
+** Voter health is judged once per window of this many epochs. It must be
+** longer than the interval between two values of a healthy replica, or
+** that replica is masked as stale.
+*/
+#define TEC_HEALTH_WINDOW_EPOCHS 20
+
+/*
+** Performance log instrumentation of the TEC processing stages.
+** Set to 0 to compile out every TEC_PERF_ENTRY/TEC_PERF_EXIT marker.
+*/
+#define TEC_PERF_LOG_ENABLED 1
+
+/*
+** Self-benchmark (TEC_SELF_BENCH_CC)
+**
+** The benchmark runs TEC_SELF_BENCH_SLICE_OPS operations per kernel after each
+** batch of messages the runloop handles, so it never holds off a vote by more
+** than one slice. Operations are timed in chunks of TEC_SELF_BENCH_CHUNK_OPS to keep
+** the clock overhead out of the per-operation figures.
+*/
+#define TEC_SELF_BENCH_SLICE_OPS      512
+#define TEC_SELF_BENCH_CHUNK_OPS      32
+#define TEC_SELF_BENCH_MAX_ITERATIONS 10000000
+
+/*
+** Hardware performance counters (perf_event_open) around TEC_TaskPipe and
+** the voter, reported in the diagnostics packet. Only Linux builds can use
+** them; elsewhere, or without permission, they switch themselves off.
+*/
+#define TEC_HWCOUNT_ENABLED 0
+
+/*
+** Critical Data Store block holding the vote state across processor and
+** app resets, see tec_cds.c. The name is unique within the app.
+*/
+#define TEC_CDS_NAME "TEC_CDS"
+
 #endif
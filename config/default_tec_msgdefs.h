@@ -42,6 +42,16 @@ typedef struct TEC_Temperature_Payload
     char Unit;
 }TEC_Temperature_Payload_t;
 
+typedef struct TEC_SelfBench_Payload
+{
+    uint32 Iterations; /**< Operations to time per kernel */
+} TEC_SelfBench_Payload_t;
+
+typedef struct TEC_CaptureStart_Payload
+{
+    char Filename[TEC_CAPTURE_FILENAME_LEN]; /**< Capture file to create */
+} TEC_CaptureStart_Payload_t;
+
 /*************************************************************************/
 /*
 ** Type definition (TEC App housekeeping)
@@ -54,6 +64,187 @@ typedef struct TEC_HkTlm_Payload
     uint8 reserved;
     char Unit;
     uint32 Temperature;
+    uint32 AgreeMask;          /**< Replicas that agreed with the last vote: bit 0 local, bit i+1 remote replica i */
+    uint32 VoterActiveMask;    /**< Voters taking part in the vote, same bit order as AgreeMask */
+    uint32 VoterProbationMask; /**< Masked voters on probation before reintegration */
+    uint32 LocalVotesLost;     /**< Votes the local node took part in and lost */
+    uint32 FirstVoteMsec;      /**< Milliseconds from app start to its first vote, 0 until then */
 } TEC_HkTlm_Payload_t;
 
+/*************************************************************************/
+/*
+** Type definition (TEC App replica exchange)
+*/
+
+/*
+** Quality flags of an exchanged sample
+*/
+#define TEC_EXCHANGE_QUALITY_VALID   0x01 /**< Raw value is within the sensor range */
+#define TEC_EXCHANGE_QUALITY_ALIGNED 0x02 /**< Taken on the shared time grid, see TEC_SAMPLE_MODE_TIME_ALIGNED */
+#define TEC_EXCHANGE_QUALITY_OVERRUN 0x04 /**< The sender dropped samples since its previous packet */
+
+/*
+** Channels of an exchanged sample, as bits of ChangedMask
+*/
+#define TEC_EXCHANGE_CHANNEL_RAW     0x01 /**< Raw */
+#define TEC_EXCHANGE_CHANNEL_QUALITY 0x02 /**< Quality */
+
+/*
+** One sample of the sender, published by its sampling task as soon as it
+** is taken. The raw value is exchanged rather than a converted temperature
+** so every node converts it to its own unit.
+*/
+typedef struct TEC_Exchange_Payload
+{
+    uint32 Epoch;       /**< Sample epoch, sample time in units of SamplePeriodMsec */
+    uint32 Raw;         /**< Raw sensor value */
+    uint8  Quality;     /**< TEC_EXCHANGE_QUALITY_ flags */
+    uint8  ChangedMask; /**< TEC_EXCHANGE_CHANNEL_ bits that changed since the previous packet */
+    uint16 Spare;
+} TEC_Exchange_Payload_t;
+
+/*************************************************************************/
+/*
+** Type definition (TEC App state transfer)
+*/
+
+/*
+** A node that has just started asks the other replicas for the vote state.
+** Nodes are named by the value of their exchange message ID.
+*/
+typedef struct TEC_StateRequest_Payload
+{
+    uint32 Requester; /**< Exchange message ID value of the node asking */
+} TEC_StateRequest_Payload_t;
+
+/*
+** The vote state of a healthy replica. Voter masks follow VoterMsgId, so
+** the requester can map them onto its own voter order.
+*/
+typedef struct TEC_StateResponse_Payload
+{
+    uint32 Responder;                  /**< Exchange message ID value of the node answering */
+    uint32 Requester;                  /**< Exchange message ID value of the node that asked */
+    uint32 Epoch;                      /**< Sample epoch of Temperature */
+    uint32 Temperature;                /**< Newest voted temperature */
+    char   Unit;                       /**< Unit of Temperature */
+    uint8  VoterCount;                 /**< Entries used in VoterMsgId */
+    uint16 Spare;
+    uint32 AgreeMask;                  /**< Voters that agreed with the vote */
+    uint32 ActiveMask;                 /**< Voters taking part in the vote */
+    uint32 ProbationMask;              /**< Masked voters on probation before reintegration */
+    uint32 VoterMsgId[TEC_MAX_VOTERS]; /**< Exchange message ID value of each voter, the responder first */
+} TEC_StateResponse_Payload_t;
+
+/*************************************************************************/
+/*
+** Type definition (TEC App diagnostics)
+*/
+
+/*
+** Message paths dispatched by TEC_TaskPipe, used to index the latency histograms
+*/
+#define TEC_DIAG_PATH_CMD     0 /**< Ground commands */
+#define TEC_DIAG_PATH_SEND_HK 1 /**< Housekeeping requests */
+#define TEC_DIAG_PATH_REPLICA 2 /**< Replica exchange packets, all replicas */
+#define TEC_DIAG_PATH_COUNT   3
+
+typedef struct TEC_LatencyHist
+{
+    uint32 Count;                            /**< Number of messages measured */
+    uint32 MaxNsec;                          /**< Largest latency seen, nanoseconds */
+    uint32 Bucket[TEC_LATENCY_HIST_BUCKETS]; /**< log2 buckets, see TEC_LATENCY_HIST_BUCKETS */
+} TEC_LatencyHist_t;
+
+/*
+** Software bus pipes, in the order they are serviced
+*/
+#define TEC_PIPE_CMD     0 /**< Ground commands, HK requests and scheduler wakeups */
+#define TEC_PIPE_REPLICA 1 /**< Replica exchange packets, from the software bus or UDP */
+#define TEC_PIPE_COUNT   2
+
+typedef struct TEC_PipeStats
+{
+    uint32 Received; /**< Messages taken from the pipe */
+    uint32 Dropped;  /**< Messages lost on the way to the pipe, from sequence count gaps */
+    uint32 Rejected; /**< Messages taken from the pipe but dropped for a wrong length */
+} TEC_PipeStats_t;
+
+/*
+** Link statistics of one remote replica, from its telemetry sequence counts
+*/
+typedef struct TEC_ReplicaLinkStats
+{
+    uint32 Accepted;     /**< Packets passed on to the voter */
+    uint32 Lost;         /**< Sequence counts skipped and not received late */
+    uint32 Gaps;         /**< Breaks in the sequence */
+    uint32 Duplicates;   /**< Packets already received, dropped */
+    uint32 Late;         /**< Packets received after a newer one, dropped */
+    uint16 LossPermille; /**< Lost / (Accepted + Late + Lost), when the packet was sent */
+    uint16 Spare;
+} TEC_ReplicaLinkStats_t;
+
+/*
+** Stages measured by the hardware performance counters
+*/
+#define TEC_HWCOUNT_STAGE_TASK_PIPE 0 /**< TEC_TaskPipe, one message */
+#define TEC_HWCOUNT_STAGE_VOTER     1 /**< Voter */
+#define TEC_HWCOUNT_STAGE_COUNT     2
+
+typedef struct TEC_HwCounters
+{
+    uint64 Cycles;
+    uint64 Instructions;
+    uint64 CacheMisses;
+    uint64 BranchMisses;
+    uint32 Samples; /**< Number of times the stage was measured */
+    uint32 Spare;
+} TEC_HwCounters_t;
+
+typedef struct TEC_DiagTlm_Payload
+{
+    TEC_LatencyHist_t      Handler[TEC_DIAG_PATH_COUNT];        /**< Handler execution time */
+    TEC_LatencyHist_t      ReceiveToDone[TEC_DIAG_PATH_COUNT];  /**< CFE_SB_ReceiveBuffer return to handler done */
+    uint8                  HwCountersAvailable;                 /**< Non-zero if the totals below are being collected */
+    uint8                  Spare[7];
+    TEC_HwCounters_t       HwCounters[TEC_HWCOUNT_STAGE_COUNT]; /**< Hardware counter totals per stage */
+    uint32                 SamplesConsumed;                     /**< Samples taken from the sampling task */
+    uint32                 SampleOverruns;                      /**< Samples the sampling task had to drop */
+    uint32                 Wakeups;                             /**< Scheduler wakeup messages received */
+    uint32                 ReceiveTimeouts;                     /**< Receives that timed out on a silent bus */
+    TEC_PipeStats_t        Pipe[TEC_PIPE_COUNT];                /**< Traffic per software bus pipe */
+    uint32                 ReplicaSuperseded;                   /**< Replica values replaced by a newer one for the same epoch */
+    uint32                 EpochsVoted;                         /**< Sample epochs voted on */
+    uint32                 EpochsIncomplete;                    /**< Epochs voted on at their deadline with voters missing */
+    uint32                 EpochSamplesLate;                    /**< Values for an epoch already voted on, discarded */
+    uint32                 EpochsEvicted;                       /**< Epochs dropped unvoted to make room for newer ones */
+    TEC_ReplicaLinkStats_t Replica[TEC_MAX_REPLICAS];           /**< Link statistics per remote replica */
+    int32                  SampleSkewUsec;                      /**< Newest sample: time taken minus time due */
+    uint32                 SampleSkewMaxUsec;                   /**< Largest absolute sampling skew */
+    uint32                 UdpDatagrams;                        /**< Datagrams received over the UDP transport */
+    uint32                 UdpRejected;                         /**< Malformed datagrams and packets of no configured replica */
+} TEC_DiagTlm_Payload_t;
+
+/*************************************************************************/
+/*
+** Type definition (TEC App self-benchmark results)
+*/
+
+typedef struct TEC_KernelTiming
+{
+    uint32 Operations; /**< Operations timed */
+    uint32 MinNsec;    /**< Fastest chunk, nanoseconds per operation */
+    uint32 MeanNsec;   /**< Mean, nanoseconds per operation */
+    uint32 MaxNsec;    /**< Slowest chunk, nanoseconds per operation */
+} TEC_KernelTiming_t;
+
+typedef struct TEC_SelfBenchTlm_Payload
+{
+    TEC_KernelTiming_t Convert;  /**< Unit conversion kernel */
+    TEC_KernelTiming_t Vote;     /**< Voting strategy of the active configuration */
+    uint32             Slices;   /**< Runloop cycles the benchmark was spread over */
+    uint32             VoteMode; /**< Strategy timed, one of the TEC_VOTE_MODE_ values */
+    uint32             Voters;   /**< Values per timed vote, the local node plus every replica */
+} TEC_SelfBenchTlm_Payload_t;
+
 #endif
@@ -31,13 +31,23 @@
 */
 #define TEC_CMD_MID     CFE_PLATFORM_CMD_TOPICID_TO_MIDV(CFE_MISSION_TEC_CMD_TOPICID) /* 0x1890 */
 #define TEC_SEND_HK_MID CFE_PLATFORM_CMD_TOPICID_TO_MIDV(CFE_MISSION_TEC_SEND_HK_TOPICID) /* 0x1891 */
+#define TEC_WAKEUP_MID  CFE_PLATFORM_CMD_TOPICID_TO_MIDV(CFE_MISSION_TEC_WAKEUP_TOPICID) /* 0x18A1 */
 
 /*
 ** TEC Telemetry Message Id's
 */
 #define TEC_HK_TLM_MID          CFE_PLATFORM_TLM_TOPICID_TO_MIDV(CFE_MISSION_TEC_HK_TLM_TOPICID) /* 0x0891 */
+#define TEC_DIAG_TLM_MID        CFE_PLATFORM_TLM_TOPICID_TO_MIDV(CFE_MISSION_TEC_DIAG_TLM_TOPICID) /* 0x0893 */
+#define TEC_SELF_BENCH_TLM_MID  CFE_PLATFORM_TLM_TOPICID_TO_MIDV(CFE_MISSION_TEC_SELF_BENCH_TLM_TOPICID) /* 0x08A0 */
+#define TEC_EXCHANGE_TLM_MID    CFE_PLATFORM_TLM_TOPICID_TO_MIDV(CFE_MISSION_TEC_EXCHANGE_TLM_TOPICID) /* 0x08A2 */
 
-#define CPUA_HK_MID CFE_PLATFORM_TLM_TOPICID_TO_MIDV(CFE_MISSION_TEC_HK_TLM_TOPICID + 3) /* 0x0891 */
-#define CPUB_HK_MID CFE_PLATFORM_TLM_TOPICID_TO_MIDV(CFE_MISSION_TEC_HK_TLM_TOPICID + 6) /* 0x0897 */
+/*
+** State transfer between replicas, one message ID shared by every node
+*/
+#define TEC_STATE_REQ_MID CFE_PLATFORM_TLM_TOPICID_TO_MIDV(CFE_MISSION_TEC_STATE_REQ_TOPICID) /* 0x08A3 */
+#define TEC_STATE_RSP_MID CFE_PLATFORM_TLM_TOPICID_TO_MIDV(CFE_MISSION_TEC_STATE_RSP_TOPICID) /* 0x08A4 */
+
+#define CPUA_EXCHANGE_MID CFE_PLATFORM_TLM_TOPICID_TO_MIDV(CFE_MISSION_TEC_EXCHANGE_TLM_TOPICID + 3) /* 0x08A5 */
+#define CPUB_EXCHANGE_MID CFE_PLATFORM_TLM_TOPICID_TO_MIDV(CFE_MISSION_TEC_EXCHANGE_TLM_TOPICID + 6) /* 0x08A8 */
 
 #endif
@@ -70,7 +70,29 @@ typedef struct
 {
     CFE_MSG_CommandHeader_t CommandHeader; /**< \brief Command header */
     TEC_Temperature_Payload_t Payload;
-} TEC_TemperatureHkCmd_t;
+} TEC_GetTemperatureCmd_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CommandHeader; /**< \brief Command header */
+} TEC_ResetDiagCmd_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CommandHeader; /**< \brief Command header */
+    TEC_SelfBench_Payload_t Payload;
+} TEC_SelfBenchCmd_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t    CommandHeader; /**< \brief Command header */
+    TEC_CaptureStart_Payload_t Payload;
+} TEC_CaptureStartCmd_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CommandHeader; /**< \brief Command header */
+} TEC_CaptureStopCmd_t;
 
 /*************************************************************************/
 /*
@@ -82,10 +104,63 @@ typedef struct
     CFE_MSG_CommandHeader_t CommandHeader; /**< \brief Command header */
 } TEC_SendHkCmd_t;
 
+/*
+** Periodic wakeup from the scheduler, no payload
+*/
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CommandHeader; /**< \brief Command header */
+} TEC_WakeupCmd_t;
+
 typedef struct
 {
     CFE_MSG_TelemetryHeader_t  TelemetryHeader; /**< \brief Telemetry header */
     TEC_HkTlm_Payload_t Payload;         /**< \brief Telemetry payload */
 } TEC_HkTlm_t;
 
+/*************************************************************************/
+/*
+** Type definition (TEC App replica exchange)
+*/
+
+typedef struct
+{
+    CFE_MSG_TelemetryHeader_t TelemetryHeader; /**< \brief Telemetry header */
+    TEC_Exchange_Payload_t    Payload;         /**< \brief Telemetry payload */
+} TEC_ExchangeTlm_t;
+
+/*************************************************************************/
+/*
+** Type definition (TEC App state transfer)
+*/
+
+typedef struct
+{
+    CFE_MSG_TelemetryHeader_t  TelemetryHeader; /**< \brief Telemetry header */
+    TEC_StateRequest_Payload_t Payload;         /**< \brief Telemetry payload */
+} TEC_StateRequestTlm_t;
+
+typedef struct
+{
+    CFE_MSG_TelemetryHeader_t   TelemetryHeader; /**< \brief Telemetry header */
+    TEC_StateResponse_Payload_t Payload;         /**< \brief Telemetry payload */
+} TEC_StateResponseTlm_t;
+
+/*************************************************************************/
+/*
+** Type definition (TEC App diagnostics)
+*/
+
+typedef struct
+{
+    CFE_MSG_TelemetryHeader_t TelemetryHeader; /**< \brief Telemetry header */
+    TEC_DiagTlm_Payload_t     Payload;         /**< \brief Telemetry payload */
+} TEC_DiagTlm_t;
+
+typedef struct
+{
+    CFE_MSG_TelemetryHeader_t  TelemetryHeader; /**< \brief Telemetry header */
+    TEC_SelfBenchTlm_Payload_t Payload;         /**< \brief Telemetry payload */
+} TEC_SelfBenchTlm_t;
+
 #endif /* TEC_MSGSTRUCT_H */
@@ -23,6 +23,13 @@
 #ifndef TEC_PERFIDS_H
 #define TEC_PERFIDS_H
 
-#define TEC_PERF_ID 91
+#define TEC_PERF_ID             91 /* TEC_Main runloop, excluding the pend on the command pipe */
+#define TEC_READ_TEMP_PERF_ID   92 /* TEC_ReadTemperature */
+#define TEC_TASK_PIPE_PERF_ID   93 /* TEC_TaskPipe, one message */
+#define TEC_VOTER_PERF_ID       94 /* TEC_MajorityVoter */
+#define TEC_SEND_HK_PERF_ID     95 /* TEC_SendHkCmd, excluding table management */
+#define TEC_TBL_MANAGE_PERF_ID  96 /* CFE_TBL_Manage loop in TEC_SendHkCmd */
+#define TEC_SELF_BENCH_PERF_ID  97 /* One self-benchmark slice */
+#define TEC_SAMPLE_TASK_PERF_ID 98 /* Sampling child task, one sample */
 
 #endif
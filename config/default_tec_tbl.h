@@ -31,6 +31,7 @@
 #include "tec_tblstruct.h"
 
 /* Define filenames of default data images for tables */
-#define TEC_TABLE_FILE "/cf/tec_tbl.tbl"
+#define TEC_TABLE_FILE        "/cf/tec_tbl.tbl"
+#define TEC_CONFIG_TABLE_FILE "/cf/tec_config_tbl.tbl"
 
 #endif
@@ -42,4 +42,33 @@ typedef struct
     uint16 Int2;
 } TEC_ExampleTable_t;
 
+/*
+** UDP address and port of one node
+*/
+typedef struct
+{
+    char   Address[TEC_UDP_ADDRESS_LEN]; /**< Dotted IPv4 address */
+    uint32 Port;                         /**< UDP port, 1 to 65535 */
+} TEC_UdpEndpoint_t;
+
+/*
+** TEC configuration table
+*/
+typedef struct
+{
+    uint32            SamplePeriodMsec;               /**< Period of the sampling child task */
+    uint32            SampleMode;                     /**< One of the TEC_SAMPLE_MODE_ values */
+    uint32            SamplePhaseMsec;                /**< Offset of the time aligned samples into each period */
+    uint32            VoteMode;                       /**< One of the TEC_VOTE_MODE_ values */
+    uint32            VoteTolerance;                  /**< Largest difference from the voted value still counted as agreement */
+    uint32            LocalExchangeMsgId;             /**< Exchange message ID value this node publishes on */
+    uint32            ReplicaCount;                   /**< Number of entries used in ReplicaMsgId */
+    uint32            ReplicaMsgId[TEC_MAX_REPLICAS]; /**< Exchange message ID value of each remote replica */
+    uint32            VoteWeight[TEC_MAX_VOTERS];     /**< Weight of the local node, then of each remote replica */
+    uint32            Transport;                      /**< One of the TEC_TRANSPORT_ values */
+    uint32            UdpBatch;                       /**< Exchange packets per datagram, 1 to TEC_UDP_BATCH_MAX */
+    TEC_UdpEndpoint_t UdpLocal;                       /**< Address and port this node receives on */
+    TEC_UdpEndpoint_t UdpPeer[TEC_MAX_REPLICAS];      /**< Address and port of each remote replica */
+} TEC_ConfigTable_t;
+
 #endif
@@ -27,5 +27,11 @@
 #define CFE_MISSION_TEC_SEND_HK_TOPICID         0x91
 #define CFE_MISSION_TEC_HK_TLM_TOPICID          0x91
 #define CFE_MISSION_TEC_HK_TLM_REMAP_TOPICID    0x92
+#define CFE_MISSION_TEC_DIAG_TLM_TOPICID        0x93
+#define CFE_MISSION_TEC_SELF_BENCH_TLM_TOPICID  0xA0
+#define CFE_MISSION_TEC_WAKEUP_TOPICID          0xA1
+#define CFE_MISSION_TEC_EXCHANGE_TLM_TOPICID    0xA2
+#define CFE_MISSION_TEC_STATE_REQ_TOPICID       0xA3
+#define CFE_MISSION_TEC_STATE_RSP_TOPICID       0xA4
 
 #endif
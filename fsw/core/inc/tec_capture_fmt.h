@@ -0,0 +1,233 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * TEC software bus capture file format
+ *
+ * A capture file is one TEC_CaptureFileHdr_t followed by records, each a
+ * TEC_CaptureRecordHdr_t and then Size bytes of the Type it names:
+ *  - every buffer handed to TEC_TaskPipe, exactly as received;
+ *  - every local sample filed for the vote and every pass of the voter,
+ *    the vote inputs that do not arrive as messages;
+ *  - the vote state when the capture starts and after every change made
+ *    to it outside the vote path (table load, unit command, state
+ *    transfer).
+ * Replaying the records through tec_core_voter.h in order repeats the
+ * vote of the node that wrote them. The file header names the message IDs
+ * the node dispatched on, so the replay sorts the messages the same way
+ * whatever topic IDs the mission configured.
+ *
+ * Every structure below holds only uint32_t fields, so has the same layout
+ * on every host, and each field is stored little endian whatever the byte
+ * order of the node; TEC_Core_CaptureLE32 converts. Message records are
+ * kept as received: CCSDS headers are big endian, the payload is in the
+ * byte order of the node, which the file header records.
+ */
+
+#ifndef TEC_CAPTURE_FMT_H
+#define TEC_CAPTURE_FMT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "tec_core_voter.h"
+
+/************************************************************************
+** Macro Definitions
+*************************************************************************/
+
+#define TEC_CAPTURE_MAGIC   0x54454343 /* "TECC" */
+#define TEC_CAPTURE_VERSION 4
+
+/*
+** File header flags
+*/
+#define TEC_CAPTURE_FLAG_BIG_ENDIAN 0x00000001 /* Message payloads are big endian */
+
+/*
+** Record types
+*/
+#define TEC_CAPTURE_RECORD_MSG    0 /* Software bus message */
+#define TEC_CAPTURE_RECORD_VOTER  1 /* TEC_CaptureVoter_t */
+#define TEC_CAPTURE_RECORD_SAMPLE 2 /* TEC_CaptureSample_t */
+#define TEC_CAPTURE_RECORD_TICK   3 /* TEC_CaptureTick_t */
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+typedef struct
+{
+    uint32_t Magic;   /**< TEC_CAPTURE_MAGIC */
+    uint32_t Version; /**< TEC_CAPTURE_VERSION */
+    uint32_t Flags;   /**< TEC_CAPTURE_FLAG_ values */
+
+    /* Message ID values of the writing node */
+    uint32_t CmdMsgId;      /**< TEC_CMD_MID */
+    uint32_t SendHkMsgId;   /**< TEC_SEND_HK_MID */
+    uint32_t WakeupMsgId;   /**< TEC_WAKEUP_MID */
+    uint32_t StateReqMsgId; /**< TEC_STATE_REQ_MID */
+    uint32_t StateRspMsgId; /**< TEC_STATE_RSP_MID */
+} TEC_CaptureFileHdr_t;
+
+typedef struct
+{
+    uint32_t Seconds;     /**< Record time, monotonic clock, whole seconds */
+    uint32_t Nanoseconds; /**< Record time, fraction of the second */
+    uint32_t Size;        /**< Size of the record that follows, bytes */
+    uint32_t Type;        /**< One of the TEC_CAPTURE_RECORD_ values */
+} TEC_CaptureRecordHdr_t;
+
+/**
+ * Local sample, see TEC_Core_VoterLocal
+ */
+typedef struct
+{
+    uint32_t Epoch; /**< Sample epoch */
+    uint32_t Raw;   /**< Raw sensor value */
+} TEC_CaptureSample_t;
+
+/**
+ * Pass of the voter: TEC_Core_VoterLocalHealthy, then TEC_Core_VoterNext
+ * and TEC_Core_VoterVote until no epoch is ready, then
+ * TEC_Core_VoterHealthUpdate
+ */
+typedef struct
+{
+    uint32_t Now;          /**< Current epoch */
+    uint32_t LocalHealthy; /**< The local sensor could be read */
+} TEC_CaptureTick_t;
+
+/**
+ * Sequence count state of one replica, TEC_Core_SeqTracker_t
+ */
+typedef struct
+{
+    uint32_t Last;    /**< Newest sequence count received */
+    uint32_t Valid;   /**< Last is valid */
+    uint32_t Missing; /**< Counts before Last not received */
+} TEC_CaptureSeq_t;
+
+/**
+ * Link statistics of one replica, TEC_Core_LinkStats_t
+ */
+typedef struct
+{
+    uint32_t Accepted;
+    uint32_t Lost;
+    uint32_t Gaps;
+    uint32_t Duplicates;
+    uint32_t Late;
+} TEC_CaptureLink_t;
+
+/**
+ * One epoch of the epoch buffer, TEC_Core_EpochSlot_t
+ */
+typedef struct
+{
+    uint32_t Epoch;                        /**< Epoch held by the slot */
+    uint32_t Present;                      /**< Voters with a value, 0 if the slot is free */
+    uint32_t Value[TEC_CORE_EPOCH_VOTERS]; /**< Value of each voter */
+} TEC_CaptureSlot_t;
+
+/**
+ * Vote state, everything in TEC_Core_Voter_t but the strategy pointer,
+ * which TEC_Core_CaptureVoterLoad resolves again from Mode
+ */
+typedef struct
+{
+    /* Vote parameters, TEC_Core_VoterConfig_t */
+    uint32_t Mode;
+    uint32_t Tolerance;
+    uint32_t Weight[TEC_CORE_VOTER_MAX];
+    uint32_t MinVoters;
+    uint32_t DeadlineEpochs;
+    uint32_t HealthWindow;
+    uint32_t Unit; /**< Unit character */
+
+    /* Membership */
+    uint32_t         ReplicaCount;
+    uint32_t         ReplicaId[TEC_CORE_VOTER_REPLICAS];
+    TEC_CaptureSeq_t ReplicaSeq[TEC_CORE_VOTER_REPLICAS];
+
+    /* Health, TEC_Core_Health_t, and the voters with a usable value */
+    uint32_t Configured;
+    uint32_t Active;
+    uint32_t Probation;
+    uint32_t Seen;
+    uint32_t Voted;
+    uint32_t Agreed;
+    uint32_t Checked;
+    uint32_t Disagreed;
+    uint32_t WindowStart;
+    uint32_t WindowOpen;
+    uint32_t HealthyMask;
+
+    /* Newest vote */
+    uint32_t Temperature;
+    uint32_t VotedEpoch;
+    uint32_t AgreeMask;
+    uint32_t LocalVotesLost;
+    uint32_t VoteValid;
+
+    /* Epoch buffer, TEC_Core_EpochBuffer_t */
+    TEC_CaptureSlot_t Slot[TEC_CORE_EPOCH_SLOTS];
+    uint32_t          LastVoted;
+    uint32_t          HaveVoted;
+
+    /* Statistics, TEC_Core_VoterStats_t */
+    uint32_t          EpochsVoted;
+    uint32_t          EpochsIncomplete;
+    uint32_t          EpochSamplesLate;
+    uint32_t          EpochsEvicted;
+    uint32_t          ReplicaSuperseded;
+    TEC_CaptureLink_t Link[TEC_CORE_VOTER_REPLICAS];
+} TEC_CaptureVoter_t;
+
+/************************************************************************
+** Function Prototypes
+*************************************************************************/
+
+/**
+ * \brief Convert a value between host byte order and the file's
+ *
+ * The conversion is its own inverse, so it serves for reading and writing.
+ */
+uint32_t TEC_Core_CaptureLE32(uint32_t Value);
+
+/**
+ * \brief Flags of the file header for this host
+ */
+uint32_t TEC_Core_CaptureFlags(void);
+
+/**
+ * \brief Write the vote state into a record
+ */
+void TEC_Core_CaptureVoterSave(const TEC_Core_Voter_t *Voter, TEC_CaptureVoter_t *Record);
+
+/**
+ * \brief Rebuild the vote state from a record
+ *
+ * \return false, leaving Voter cleared by TEC_Core_VoterInit, if the
+ *         record holds an unknown vote mode or too many replicas
+ */
+bool TEC_Core_CaptureVoterLoad(TEC_Core_Voter_t *Voter, const TEC_CaptureVoter_t *Record);
+
+#endif /* TEC_CAPTURE_FMT_H */
@@ -0,0 +1,166 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * TEC core library: sensor acquisition, unit conversion and voting kernels
+ *
+ * This library has no cFE or OSAL dependency so the exact code that flies
+ * in the TEC app can also be built and profiled on a plain host.
+ */
+
+#ifndef TEC_CORE_H
+#define TEC_CORE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/************************************************************************
+** Macro Definitions
+*************************************************************************/
+
+#define TEC_CORE_UNIT_CELSIUS    'C'
+#define TEC_CORE_UNIT_FAHRENHEIT 'F'
+
+#define TEC_CORE_RAW_MAX 255 /* Largest value the sensor reads */
+
+#define TEC_CORE_VOTE_MASK_BITS 32 /* Replicas reported in the agreement mask of a vote */
+
+#define TEC_CORE_SEQ_MODULUS 0x4000 /* CCSDS packet sequence counts are 14 bits wide */
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+/**
+ * \brief Place of a packet in its stream, see TEC_Core_SequenceTrack
+ */
+typedef enum
+{
+    TEC_CORE_SEQ_NEXT = 0, /**< Directly follows the newest packet, or (re)starts the stream */
+    TEC_CORE_SEQ_GAP,      /**< Newer than the newest packet, with packets missing in between */
+    TEC_CORE_SEQ_LATE,     /**< One of the missing packets, arriving after a newer one */
+    TEC_CORE_SEQ_DUPLICATE /**< Already received */
+} TEC_Core_SeqClass_t;
+
+/**
+ * \brief Sequence count state of one packet stream
+ */
+typedef struct
+{
+    uint16_t Last;    /**< Newest sequence count received */
+    bool     Valid;   /**< Last is valid */
+    uint32_t Missing; /**< Bit i set if count Last - 1 - i has not been received */
+} TEC_Core_SeqTracker_t;
+
+/**
+ * \brief Outcome of a majority vote, seen from the local node
+ */
+typedef enum
+{
+    TEC_CORE_VOTE_AGREED = 0,  /**< The local value holds the majority */
+    TEC_CORE_VOTE_OUTVOTED,    /**< A majority of the replicas disagrees with the local value */
+    TEC_CORE_VOTE_NO_MAJORITY  /**< No value holds a majority */
+} TEC_Core_VoteOutcome_t;
+
+/************************************************************************
+** Function Prototypes
+*************************************************************************/
+
+/**
+ * \brief Acquire one raw sample from the temperature sensor
+ *
+ * \return Raw sensor value between 0 and TEC_CORE_RAW_MAX
+ */
+uint32_t TEC_Core_ReadRawSensor(void);
+
+/**
+ * \brief Convert a raw sample to the requested unit
+ *
+ * \param[in]  Raw       Raw sensor value (Celsius)
+ * \param[in]  Unit      TEC_CORE_UNIT_CELSIUS or TEC_CORE_UNIT_FAHRENHEIT
+ * \param[out] Converted Converted value, in Celsius if the unit is invalid
+ *
+ * \return true if the unit is valid
+ */
+bool TEC_Core_ConvertTemperature(uint32_t Raw, char Unit, uint32_t *Converted);
+
+/**
+ * \brief Majority vote over the values of all replicas
+ *
+ * Values[0] is the local value, the others come from the remote replicas.
+ * A value wins if strictly more than half of the replicas report it.
+ * Runs in O(Count) time and constant space (Boyer-Moore majority vote).
+ *
+ * \param[in]  Values    Replica values, local value first
+ * \param[in]  Count     Number of entries in Values
+ * \param[out] Voted     Winning value, left untouched if there is no majority
+ * \param[out] AgreeMask Bit i set if Values[i] equals the winner, for the first
+ *                       TEC_CORE_VOTE_MASK_BITS replicas; 0 if there is no
+ *                       majority. May be NULL.
+ *
+ * \return Outcome of the vote
+ */
+TEC_Core_VoteOutcome_t TEC_Core_MajorityVote(const uint32_t *Values, uint32_t Count, uint32_t *Voted,
+                                             uint32_t *AgreeMask);
+
+/**
+ * \brief Number of sequence counts skipped between two packets of one stream
+ *
+ * Counts wrap at TEC_CORE_SEQ_MODULUS. A step of more than half the range
+ * is taken as a duplicate or a late packet rather than a loss.
+ *
+ * \param[in] Last Sequence count of the previous packet
+ * \param[in] Now  Sequence count of this packet
+ *
+ * \return Packets missing between the two, 0 if Now directly follows Last
+ */
+uint32_t TEC_Core_SequenceGap(uint16_t Last, uint16_t Now);
+
+/**
+ * \brief Next instant of a fixed sampling grid shared by all nodes
+ *
+ * The grid holds every time t with t mod Period == Phase, counted from the
+ * time epoch, so nodes that agree on the time sample together.
+ *
+ * \param[in] NowUsec    Current time in microseconds
+ * \param[in] PeriodMsec Grid period, non-zero
+ * \param[in] PhaseMsec  Offset of the grid into each period, below PeriodMsec
+ *
+ * \return First grid instant strictly after NowUsec, in microseconds
+ */
+uint64_t TEC_Core_NextAlignedUsec(uint64_t NowUsec, uint32_t PeriodMsec, uint32_t PhaseMsec);
+
+/**
+ * \brief Classify the sequence count of a received packet and update the stream state
+ *
+ * Remembers which of the last 32 counts are missing, so a late packet is
+ * told apart from a duplicate. Duplicates leave the state unchanged. A
+ * count more than 32 behind the newest is taken as a restart of the sender
+ * and starts the stream afresh.
+ *
+ * \param[in,out] Tracker Stream state, zeroed before the first packet
+ * \param[in]     Now     Sequence count of the packet
+ * \param[out]    Missed  Packets skipped, for TEC_CORE_SEQ_GAP; 0 otherwise
+ *
+ * \return Class of the packet
+ */
+TEC_Core_SeqClass_t TEC_Core_SequenceTrack(TEC_Core_SeqTracker_t *Tracker, uint16_t Now, uint32_t *Missed);
+
+#endif /* TEC_CORE_H */
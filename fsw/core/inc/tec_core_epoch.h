@@ -0,0 +1,139 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Per-epoch slot buffer for aligning replica samples before a vote
+ *
+ * Time is cut into epochs of one sample period. Every voter stores its
+ * value for an epoch in the slot of that epoch; an epoch is handed out for
+ * voting exactly once, oldest first, when every expected voter has
+ * reported or when its deadline has passed. Values for an epoch that has
+ * already been handed out are late and refused.
+ */
+
+#ifndef TEC_CORE_EPOCH_H
+#define TEC_CORE_EPOCH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/************************************************************************
+** Macro Definitions
+*************************************************************************/
+
+#define TEC_CORE_EPOCH_SLOTS  16 /* Epochs held at once, must be a power of two */
+#define TEC_CORE_EPOCH_VOTERS 32 /* Voters per epoch, one bit each in Present */
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+typedef struct
+{
+    uint32_t Epoch;                        /**< Epoch held by the slot */
+    uint32_t Present;                      /**< Bit i set if Value[i] holds voter i's value, 0 if the slot is free */
+    uint32_t Value[TEC_CORE_EPOCH_VOTERS]; /**< Value of each voter */
+} TEC_Core_EpochSlot_t;
+
+typedef struct
+{
+    TEC_Core_EpochSlot_t Slot[TEC_CORE_EPOCH_SLOTS];
+    uint32_t             LastVoted; /**< Newest epoch handed out for voting */
+    bool                 HaveVoted; /**< LastVoted is valid */
+} TEC_Core_EpochBuffer_t;
+
+/**
+ * \brief Result of storing one value
+ */
+typedef enum
+{
+    TEC_CORE_EPOCH_STORED = 0, /**< Stored */
+    TEC_CORE_EPOCH_SUPERSEDED, /**< Stored, replacing an earlier value of the same voter for the epoch */
+    TEC_CORE_EPOCH_EVICTED,    /**< Stored, an older epoch that could have been voted on was dropped for room */
+    TEC_CORE_EPOCH_LATE        /**< Not stored, the epoch has been voted on or is outside the buffer */
+} TEC_Core_EpochStore_t;
+
+/************************************************************************
+** Function Prototypes
+*************************************************************************/
+
+/**
+ * \brief Epoch of a time given in seconds and 2^-32 subseconds
+ *
+ * \param[in] Seconds    Seconds part of the time
+ * \param[in] Subseconds Subseconds part of the time
+ * \param[in] PeriodMsec Length of one epoch, non-zero
+ */
+uint32_t TEC_Core_EpochOf(uint32_t Seconds, uint32_t Subseconds, uint32_t PeriodMsec);
+
+/**
+ * \brief Drop all epochs and forget the last vote
+ */
+void TEC_Core_EpochInit(TEC_Core_EpochBuffer_t *Buffer);
+
+/**
+ * \brief Store the value of one voter for one epoch
+ *
+ * \param[in] Buffer    Epoch buffer
+ * \param[in] Epoch     Epoch of the value
+ * \param[in] Voter     Voter index, below TEC_CORE_EPOCH_VOTERS
+ * \param[in] Value     Value to store
+ * \param[in] MinVoters Voters an epoch needs to be voted on, see TEC_Core_EpochNext
+ *
+ * \return What happened to the value
+ */
+TEC_Core_EpochStore_t TEC_Core_EpochStore(TEC_Core_EpochBuffer_t *Buffer, uint32_t Epoch, uint32_t Voter,
+                                          uint32_t Value, uint32_t MinVoters);
+
+/**
+ * \brief Take the oldest epoch that is ready to be voted on
+ *
+ * The oldest epoch held is ready once every voter in ActiveMask has
+ * reported or once Now is DeadlineEpochs or more past it. Newer epochs wait
+ * until the older ones are ready so epochs are voted on in order. A ready
+ * epoch with fewer than MinVoters values from ActiveMask is dropped without
+ * being returned; values of other voters do not count, but are still in
+ * the copy returned.
+ *
+ * \param[in]  Buffer         Epoch buffer
+ * \param[in]  Now            Current epoch
+ * \param[in]  DeadlineEpochs Epochs to wait for missing voters
+ * \param[in]  ActiveMask     Voters that take part in the vote
+ * \param[in]  MinVoters      Fewest values from ActiveMask worth a vote
+ * \param[out] Slot           Copy of the epoch taken, when true is returned
+ *
+ * \return true if an epoch was taken, false if none is ready
+ */
+bool TEC_Core_EpochNext(TEC_Core_EpochBuffer_t *Buffer, uint32_t Now, uint32_t DeadlineEpochs, uint32_t ActiveMask,
+                        uint32_t MinVoters, TEC_Core_EpochSlot_t *Slot);
+
+/**
+ * \brief Carry on from an epoch voted on elsewhere
+ *
+ * Epochs up to and including LastVoted are dropped and values for them
+ * are refused from then on, as if they had been voted on here. Does
+ * nothing if the buffer has already moved past LastVoted.
+ *
+ * \param[in] Buffer    Epoch buffer
+ * \param[in] LastVoted Newest epoch already voted on
+ */
+void TEC_Core_EpochResume(TEC_Core_EpochBuffer_t *Buffer, uint32_t LastVoted);
+
+#endif /* TEC_CORE_EPOCH_H */
@@ -0,0 +1,98 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Fusion kernels beyond the plain and median votes: tolerance majority,
+ * weighted average and first healthy replica
+ *
+ * All of them take the replica values local value first, accept 1 to
+ * TEC_CORE_SORT_MAX values and report agreement the same way as
+ * TEC_Core_ToleranceVote.
+ */
+
+#ifndef TEC_CORE_FUSION_H
+#define TEC_CORE_FUSION_H
+
+#include <stdint.h>
+
+#include "tec_core.h"
+#include "tec_core_median.h"
+
+/************************************************************************
+** Function Prototypes
+*************************************************************************/
+
+/**
+ * \brief Majority vote where values within Tolerance of each other count as equal
+ *
+ * The candidate is the replica value with the most replicas within
+ * Tolerance of it, the lowest index on a tie so the local value is
+ * preferred. O(Count^2).
+ *
+ * \param[in]  Values    Replica values, local value first
+ * \param[in]  Count     Number of entries in Values
+ * \param[in]  Tolerance Largest difference still counted as agreement
+ * \param[out] Voted     Winning value, left untouched if there is no majority
+ * \param[out] AgreeMask Bit i set if Values[i] agreed, 0 if there is no majority. May be NULL.
+ *
+ * \return Outcome of the vote
+ */
+TEC_Core_VoteOutcome_t TEC_Core_ToleranceMajorityVote(const uint32_t *Values, uint32_t Count, uint32_t Tolerance,
+                                                      uint32_t *Voted, uint32_t *AgreeMask);
+
+/**
+ * \brief Weighted mean of the replica values, checked with a tolerance band
+ *
+ * The mean is rounded to the nearest integer. Replicas with weight 0 do not
+ * contribute to the mean but are still checked against it. There is no
+ * majority if all weights are 0.
+ *
+ * \param[in]  Values    Replica values, local value first
+ * \param[in]  Weights   Weight of each replica, at most 0xFFFF each
+ * \param[in]  Count     Number of entries in Values and Weights
+ * \param[in]  Tolerance Largest difference still counted as agreement
+ * \param[out] Voted     Weighted mean, left untouched if there is no majority
+ * \param[out] AgreeMask Bit i set if Values[i] agreed, 0 if there is no majority. May be NULL.
+ *
+ * \return Outcome of the vote
+ */
+TEC_Core_VoteOutcome_t TEC_Core_WeightedAverageVote(const uint32_t *Values, const uint32_t *Weights, uint32_t Count,
+                                                    uint32_t Tolerance, uint32_t *Voted, uint32_t *AgreeMask);
+
+/**
+ * \brief Take the value of the first healthy replica, in index order
+ *
+ * No majority is required: the result is TEC_CORE_VOTE_NO_MAJORITY only if
+ * no replica is healthy. The local node is outvoted if it is unhealthy or
+ * further than Tolerance from the selected value.
+ *
+ * \param[in]  Values      Replica values, local value first
+ * \param[in]  Count       Number of entries in Values
+ * \param[in]  HealthyMask Bit i set if Values[i] may be used
+ * \param[in]  Tolerance   Largest difference still counted as agreement
+ * \param[out] Voted       Selected value, left untouched if no replica is healthy
+ * \param[out] AgreeMask   Bit i set if Values[i] is healthy and within Tolerance. May be NULL.
+ *
+ * \return Outcome of the vote
+ */
+TEC_Core_VoteOutcome_t TEC_Core_FirstHealthyVote(const uint32_t *Values, uint32_t Count, uint32_t HealthyMask,
+                                                 uint32_t Tolerance, uint32_t *Voted, uint32_t *AgreeMask);
+
+#endif /* TEC_CORE_FUSION_H */
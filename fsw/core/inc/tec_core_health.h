@@ -0,0 +1,117 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Voter health: staleness and lost-vote masking with probation
+ *
+ * Every voter is one bit in a set of 32 bit masks, so recording a report
+ * or a vote and evaluating a health window are a handful of word
+ * operations whatever the number of voters.
+ *
+ * Health is judged once per window of epochs:
+ *  - an active voter that did not report at all is stale and is masked;
+ *  - an active voter that took part in votes with a majority and never
+ *    agreed is losing and is masked;
+ *  - a masked voter whose values agreed with every vote it was checked
+ *    against moves to probation, and after another such window becomes
+ *    active again; any disagreement sends it back to masked.
+ * The last active voter is never masked, so the vote keeps running from
+ * TMR through duplex down to simplex.
+ */
+
+#ifndef TEC_CORE_HEALTH_H
+#define TEC_CORE_HEALTH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+typedef struct
+{
+    uint32_t Configured;  /**< Voters in the membership */
+    uint32_t Active;      /**< Voters taking part in the vote */
+    uint32_t Probation;   /**< Masked voters that had one clean window */
+    uint32_t Seen;        /**< Voters that reported in this window */
+    uint32_t Voted;       /**< Active voters that took part in a vote with a majority in this window */
+    uint32_t Agreed;      /**< Active voters that agreed at least once in this window */
+    uint32_t Checked;     /**< Inactive voters compared with at least one vote in this window */
+    uint32_t Disagreed;   /**< Inactive voters that disagreed with a vote in this window */
+    uint32_t WindowStart; /**< First epoch of this window */
+    bool     WindowOpen;  /**< WindowStart is valid */
+} TEC_Core_Health_t;
+
+/************************************************************************
+** Function Prototypes
+*************************************************************************/
+
+/**
+ * \brief Make every voter of the membership active and start afresh
+ */
+void TEC_Core_HealthInit(TEC_Core_Health_t *Health, uint32_t Configured);
+
+/**
+ * \brief Record that a voter reported a value
+ */
+void TEC_Core_HealthSeen(TEC_Core_Health_t *Health, uint32_t Voter);
+
+/**
+ * \brief Record the result of one vote that reached a majority
+ *
+ * \param[in] Health    Voter health
+ * \param[in] Voters    Active voters that took part
+ * \param[in] AgreeMask Active voters that agreed
+ * \param[in] Shadow    Inactive voters whose value was compared with the result
+ * \param[in] ShadowOk  Inactive voters whose value would have agreed
+ */
+void TEC_Core_HealthVote(TEC_Core_Health_t *Health, uint32_t Voters, uint32_t AgreeMask, uint32_t Shadow,
+                         uint32_t ShadowOk);
+
+/**
+ * \brief Close the health window once it is Window epochs long
+ *
+ * \param[in]  Health       Voter health
+ * \param[in]  Now          Current epoch
+ * \param[in]  Window       Length of a health window in epochs, non-zero
+ * \param[out] Masked       Voters masked by this window
+ * \param[out] Reintegrated Voters made active again by this window
+ *
+ * \return true if the window was closed and the voter states updated
+ */
+bool TEC_Core_HealthUpdate(TEC_Core_Health_t *Health, uint32_t Now, uint32_t Window, uint32_t *Masked,
+                           uint32_t *Reintegrated);
+
+/**
+ * \brief Take over voter states judged elsewhere
+ *
+ * Only the voters in Known are changed; each becomes active, on
+ * probation or masked as Active and Probation say. Voters outside the
+ * membership are ignored and the last active voter is kept.
+ *
+ * \param[in] Health    Voter health
+ * \param[in] Known     Voters whose state is given
+ * \param[in] Active    Voters of Known that are active
+ * \param[in] Probation Voters of Known that are masked and on probation
+ */
+void TEC_Core_HealthRestore(TEC_Core_Health_t *Health, uint32_t Known, uint32_t Active, uint32_t Probation);
+
+#endif /* TEC_CORE_HEALTH_H */
@@ -0,0 +1,76 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Open-addressing map from a 32 bit key (a message ID value) to a small index
+ *
+ * Fixed size, no heap. Keys are spread with a multiplicative hash and
+ * collisions are resolved by linear probing; with the table kept at most
+ * half full a lookup touches one or two slots on average. Key 0 marks an
+ * empty slot and cannot be stored.
+ */
+
+#ifndef TEC_CORE_IDMAP_H
+#define TEC_CORE_IDMAP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/************************************************************************
+** Macro Definitions
+*************************************************************************/
+
+#define TEC_CORE_IDMAP_SLOTS_LOG2 6
+#define TEC_CORE_IDMAP_SLOTS      (1U << TEC_CORE_IDMAP_SLOTS_LOG2)
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+typedef struct
+{
+    uint32_t Key[TEC_CORE_IDMAP_SLOTS];   /**< Stored keys, 0 if the slot is empty */
+    uint8_t  Value[TEC_CORE_IDMAP_SLOTS]; /**< Index stored with each key */
+} TEC_Core_IdMap_t;
+
+/************************************************************************
+** Function Prototypes
+*************************************************************************/
+
+/**
+ * \brief Remove all entries
+ */
+void TEC_Core_IdMapInit(TEC_Core_IdMap_t *Map);
+
+/**
+ * \brief Add a key
+ *
+ * \return false if the key is 0, already present, or the map is full
+ */
+bool TEC_Core_IdMapInsert(TEC_Core_IdMap_t *Map, uint32_t Key, uint8_t Value);
+
+/**
+ * \brief Find the index stored with a key
+ *
+ * \return false if the key is not in the map
+ */
+bool TEC_Core_IdMapLookup(const TEC_Core_IdMap_t *Map, uint32_t Key, uint8_t *Value);
+
+#endif /* TEC_CORE_IDMAP_H */
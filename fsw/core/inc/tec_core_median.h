@@ -0,0 +1,115 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Branch-free mid-value-select and median voting kernels
+ *
+ * Values are ordered with fixed sorting networks (optimal ones up to 9
+ * inputs, odd-even transposition above), built from a compare-exchange
+ * that uses no data-dependent branch. The sequence of operations depends
+ * only on the number of replicas, so the run time does not depend on the
+ * values being voted on.
+ */
+
+#ifndef TEC_CORE_MEDIAN_H
+#define TEC_CORE_MEDIAN_H
+
+#include <stdint.h>
+
+#include "tec_core.h"
+
+/************************************************************************
+** Macro Definitions
+*************************************************************************/
+
+#define TEC_CORE_NETWORK_MAX 9  /* Largest input count with a dedicated sorting network */
+#define TEC_CORE_SORT_MAX    32 /* Largest input count the kernels accept */
+
+/************************************************************************
+** Function Prototypes
+*************************************************************************/
+
+/**
+ * \brief Sort up to TEC_CORE_SORT_MAX values in place, ascending
+ */
+void TEC_Core_SortNetwork(uint32_t *Values, uint32_t Count);
+
+/**
+ * \brief Mid-value select: the middle replica value, the lower one for an even count
+ *
+ * The result is always a value some replica actually reported.
+ *
+ * \param[in] Values Replica values, 1 to TEC_CORE_SORT_MAX of them
+ * \param[in] Count  Number of entries in Values
+ */
+uint32_t TEC_Core_MidValueSelect(const uint32_t *Values, uint32_t Count);
+
+/**
+ * \brief Median: the middle value, the mean of the two middle values for an even count
+ *
+ * \param[in] Values Replica values, 1 to TEC_CORE_SORT_MAX of them
+ * \param[in] Count  Number of entries in Values
+ */
+uint32_t TEC_Core_Median(const uint32_t *Values, uint32_t Count);
+
+/**
+ * \brief Check a candidate value against the replicas, with a tolerance band
+ *
+ * A replica agrees if it lies within Tolerance of Candidate. The vote holds
+ * if strictly more than half of the replicas agree. Branch free.
+ *
+ * \param[in]  Values    Replica values, local value first
+ * \param[in]  Count     Number of entries in Values, 1 to TEC_CORE_SORT_MAX
+ * \param[in]  Tolerance Largest difference still counted as agreement
+ * \param[in]  Candidate Value to check
+ * \param[out] Voted     Candidate, left untouched if there is no majority
+ * \param[out] AgreeMask Bit i set if Values[i] agreed, 0 if there is no majority. May be NULL.
+ *
+ * \return Outcome of the vote, seen from Values[0]
+ */
+TEC_Core_VoteOutcome_t TEC_Core_ToleranceVote(const uint32_t *Values, uint32_t Count, uint32_t Tolerance,
+                                              uint32_t Candidate, uint32_t *Voted, uint32_t *AgreeMask);
+
+/**
+ * \brief Vote on the mid-value select, with a tolerance band
+ *
+ * A replica agrees if it lies within Tolerance of the selected value. The
+ * vote holds if strictly more than half of the replicas agree.
+ *
+ * \param[in]  Values    Replica values, local value first
+ * \param[in]  Count     Number of entries in Values, 1 to TEC_CORE_SORT_MAX
+ * \param[in]  Tolerance Largest difference still counted as agreement
+ * \param[out] Voted     Selected value, left untouched if there is no majority
+ * \param[out] AgreeMask Bit i set if Values[i] agreed, 0 if there is no majority. May be NULL.
+ *
+ * \return Outcome of the vote, seen from Values[0]
+ */
+TEC_Core_VoteOutcome_t TEC_Core_MidValueVote(const uint32_t *Values, uint32_t Count, uint32_t Tolerance,
+                                             uint32_t *Voted, uint32_t *AgreeMask);
+
+/**
+ * \brief Vote on the median, with a tolerance band
+ *
+ * Same as TEC_Core_MidValueVote, with the median as the voted value.
+ */
+TEC_Core_VoteOutcome_t TEC_Core_MedianVote(const uint32_t *Values, uint32_t Count, uint32_t Tolerance,
+                                           uint32_t *Voted, uint32_t *AgreeMask);
+
+#endif /* TEC_CORE_MEDIAN_H */
@@ -0,0 +1,85 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Lock-free single-producer/single-consumer ring of timestamped sensor samples
+ *
+ * One task pushes, one other task pops; no locks and no OS calls. Each index
+ * is written by only one side and published with release/acquire ordering.
+ * When the ring is full the newest sample is dropped and counted.
+ */
+
+#ifndef TEC_CORE_RING_H
+#define TEC_CORE_RING_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/************************************************************************
+** Macro Definitions
+*************************************************************************/
+
+#define TEC_CORE_RING_SIZE 16 /* Must be a power of two */
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+typedef struct
+{
+    uint32_t Seconds;    /**< Sample time, seconds */
+    uint32_t Subseconds; /**< Sample time, 2^-32 seconds */
+    uint32_t Epoch;      /**< Sample epoch, fixed when the sample is stamped */
+    uint32_t Raw;        /**< Raw sensor value */
+    int32_t  SkewUsec;   /**< Time the sample was taken minus the time it was due */
+} TEC_Core_Sample_t;
+
+typedef struct
+{
+    uint32_t          Head;     /**< Next slot to write, owned by the producer */
+    uint32_t          Tail;     /**< Next slot to read, owned by the consumer */
+    uint32_t          Overruns; /**< Samples dropped because the ring was full, producer side */
+    TEC_Core_Sample_t Slot[TEC_CORE_RING_SIZE];
+} TEC_Core_SampleRing_t;
+
+/************************************************************************
+** Function Prototypes
+*************************************************************************/
+
+/**
+ * \brief Empty the ring, only while neither side is running
+ */
+void TEC_Core_RingInit(TEC_Core_SampleRing_t *Ring);
+
+/**
+ * \brief Producer side: append a sample
+ *
+ * \return false if the ring was full and the sample was dropped
+ */
+bool TEC_Core_RingPush(TEC_Core_SampleRing_t *Ring, const TEC_Core_Sample_t *Sample);
+
+/**
+ * \brief Consumer side: remove the oldest sample
+ *
+ * \return false if the ring was empty
+ */
+bool TEC_Core_RingPop(TEC_Core_SampleRing_t *Ring, TEC_Core_Sample_t *Sample);
+
+#endif /* TEC_CORE_RING_H */
@@ -0,0 +1,291 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Replica vote pipeline: membership, packet sequence tracking, epoch
+ * alignment, voting strategies and voter health
+ *
+ * Everything the TEC app does between taking a local sample or a replica
+ * exchange packet and publishing the voted temperature, with all of its
+ * state in one TEC_Core_Voter_t. The app wraps these calls with events,
+ * telemetry and performance markers; the host replay in bench/ feeds a
+ * capture through the same calls and so reproduces the flight vote.
+ */
+
+#ifndef TEC_CORE_VOTER_H
+#define TEC_CORE_VOTER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "tec_core.h"
+#include "tec_core_epoch.h"
+#include "tec_core_health.h"
+#include "tec_core_idmap.h"
+
+/************************************************************************
+** Macro Definitions
+*************************************************************************/
+
+#define TEC_CORE_VOTER_MAX      TEC_CORE_EPOCH_VOTERS    /* Voters, the local node and the remote replicas */
+#define TEC_CORE_VOTER_REPLICAS (TEC_CORE_VOTER_MAX - 1) /* Remote replicas, voter 1 + i is replica i */
+
+/*
+** Voting strategies, the values of the VoteMode table field
+*/
+#define TEC_CORE_VOTE_MODE_MAJORITY           0
+#define TEC_CORE_VOTE_MODE_MID_VALUE          1
+#define TEC_CORE_VOTE_MODE_MEDIAN             2
+#define TEC_CORE_VOTE_MODE_TOLERANCE_MAJORITY 3
+#define TEC_CORE_VOTE_MODE_WEIGHTED_AVERAGE   4
+#define TEC_CORE_VOTE_MODE_FIRST_HEALTHY      5
+#define TEC_CORE_VOTE_MODE_COUNT              6
+
+#define TEC_CORE_QUALITY_VALID 0x01 /* Quality flag of an exchanged sample whose raw value can be voted on */
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+/**
+ * \brief Sample carried in the payload of a replica exchange packet
+ */
+typedef struct
+{
+    uint32_t Epoch;       /**< Sample epoch */
+    uint32_t Raw;         /**< Raw sensor value */
+    uint8_t  Quality;     /**< Quality flags, TEC_CORE_QUALITY_VALID if Raw can be voted on */
+    uint8_t  ChangedMask; /**< Channels that changed since the previous packet */
+    uint16_t Spare;
+} TEC_Core_ExchangeSample_t;
+
+/**
+ * \brief Values of one epoch handed to a voting strategy
+ *
+ * The Count voters that reported, in voter order, local node first if it
+ * reported.
+ */
+typedef struct
+{
+    uint32_t Count;
+    uint32_t Values[TEC_CORE_VOTER_MAX];
+    uint32_t Weights[TEC_CORE_VOTER_MAX]; /**< Weight of each voter */
+    uint32_t HealthyMask;                 /**< Bit i set if voter i of the input is healthy */
+    uint32_t Tolerance;                   /**< Largest difference between values that still agree */
+} TEC_Core_VoteInput_t;
+
+/**
+ * \brief Voting strategy; AgreeMask bits follow the order of the input
+ */
+typedef TEC_Core_VoteOutcome_t (*TEC_Core_VoteFunc_t)(const TEC_Core_VoteInput_t *Input, uint32_t *Voted,
+                                                      uint32_t *AgreeMask);
+
+/**
+ * \brief Vote parameters, set from the configuration table
+ */
+typedef struct
+{
+    uint32_t Mode;                       /**< One of the TEC_CORE_VOTE_MODE_ values */
+    uint32_t Tolerance;                  /**< Largest difference between values that still agree */
+    uint32_t Weight[TEC_CORE_VOTER_MAX]; /**< Weight of each voter, for TEC_CORE_VOTE_MODE_WEIGHTED_AVERAGE */
+    uint32_t MinVoters;                  /**< Fewest values an epoch needs while two or more voters are active */
+    uint32_t DeadlineEpochs;             /**< Epochs to wait for missing voters */
+    uint32_t HealthWindow;               /**< Length of a health window in epochs, non-zero */
+} TEC_Core_VoterConfig_t;
+
+/**
+ * \brief Link statistics of one remote replica, from its packet sequence counts
+ */
+typedef struct
+{
+    uint32_t Accepted;   /**< Packets passed on to the vote */
+    uint32_t Lost;       /**< Sequence counts skipped and not received late */
+    uint32_t Gaps;       /**< Breaks in the sequence */
+    uint32_t Duplicates; /**< Packets already received, dropped */
+    uint32_t Late;       /**< Packets received after a newer one, dropped */
+} TEC_Core_LinkStats_t;
+
+typedef struct
+{
+    uint32_t             EpochsVoted;       /**< Sample epochs voted on */
+    uint32_t             EpochsIncomplete;  /**< Epochs voted on at their deadline with voters missing */
+    uint32_t             EpochSamplesLate;  /**< Values for an epoch already voted on, discarded */
+    uint32_t             EpochsEvicted;     /**< Epochs dropped unvoted to make room for newer ones */
+    uint32_t             ReplicaSuperseded; /**< Replica values replaced by a newer one for the same epoch */
+    TEC_Core_LinkStats_t Replica[TEC_CORE_VOTER_REPLICAS];
+} TEC_Core_VoterStats_t;
+
+/**
+ * \brief Complete vote state
+ *
+ * Plain data apart from VoteFunc, so a copy can be saved and reloaded;
+ * TEC_Core_VoterConfigure on the copy's Config resolves VoteFunc again.
+ */
+typedef struct
+{
+    TEC_Core_VoterConfig_t Config;
+    TEC_Core_VoteFunc_t    VoteFunc; /**< Strategy selected by Config.Mode */
+    char                   Unit;     /**< Unit every raw value is converted to */
+
+    uint32_t              ReplicaCount;
+    uint32_t              ReplicaId[TEC_CORE_VOTER_REPLICAS]; /**< Exchange message ID value of each replica */
+    TEC_Core_IdMap_t      ReplicaMap;                         /**< ReplicaId to replica index */
+    TEC_Core_SeqTracker_t ReplicaSeq[TEC_CORE_VOTER_REPLICAS];
+
+    TEC_Core_EpochBuffer_t Epochs;      /**< Values per sample epoch, voter 0 is the local node */
+    TEC_Core_Health_t      Health;      /**< Which voters take part in the vote */
+    uint32_t               HealthyMask; /**< Voters with a usable value */
+
+    uint32_t Temperature;    /**< Voted temperature, of epoch VotedEpoch if VoteValid */
+    uint32_t VotedEpoch;     /**< Epoch of the newest vote */
+    uint32_t AgreeMask;      /**< Voters that agreed with the newest vote */
+    uint32_t LocalVotesLost; /**< Votes the local node took part in and lost */
+    bool     VoteValid;      /**< Temperature holds a vote */
+
+    TEC_Core_VoterStats_t Stats;
+} TEC_Core_Voter_t;
+
+/**
+ * \brief What one vote came to, for the caller to report
+ */
+typedef struct
+{
+    uint32_t               Epoch;      /**< Epoch voted on */
+    TEC_Core_VoteOutcome_t Outcome;    /**< Outcome of the strategy */
+    uint32_t               Voters;     /**< Active voters that took part */
+    uint32_t               LocalValue; /**< Value of the local node, if it took part */
+    bool                   LocalLost;  /**< The local node took part and disagreed with a majority */
+} TEC_Core_VoteReport_t;
+
+/************************************************************************
+** Function Prototypes
+*************************************************************************/
+
+/**
+ * \brief Voting strategy of a vote mode
+ *
+ * \return The strategy, NULL if Mode is not a TEC_CORE_VOTE_MODE_ value
+ */
+TEC_Core_VoteFunc_t TEC_Core_VoteStrategy(uint32_t Mode);
+
+/**
+ * \brief Clear all state; the voter has no replicas and votes in Celsius
+ *
+ * TEC_Core_VoterConfigure must be called before the first vote.
+ */
+void TEC_Core_VoterInit(TEC_Core_Voter_t *Voter);
+
+/**
+ * \brief Take over new vote parameters, keeping the vote state
+ *
+ * \return false, changing nothing, if the vote mode is unknown
+ */
+bool TEC_Core_VoterConfigure(TEC_Core_Voter_t *Voter, const TEC_Core_VoterConfig_t *Config);
+
+/**
+ * \brief Replace the replica membership and start the vote afresh
+ *
+ * Sequence tracking, epochs, link statistics and health are reset; every
+ * member starts out active.
+ *
+ * \param[in] Voter     Vote state
+ * \param[in] ReplicaId Exchange message ID value of each replica, non-zero and unique
+ * \param[in] Count     Entries in ReplicaId, at most TEC_CORE_VOTER_REPLICAS
+ */
+void TEC_Core_VoterSetMembers(TEC_Core_Voter_t *Voter, const uint32_t *ReplicaId, uint32_t Count);
+
+/**
+ * \brief Replica index of an exchange message ID value
+ *
+ * \return false if the ID does not belong to a replica
+ */
+bool TEC_Core_VoterLookup(const TEC_Core_Voter_t *Voter, uint32_t Id, uint8_t *Replica);
+
+/**
+ * \brief File a local sample as the local node's value for its epoch
+ */
+TEC_Core_EpochStore_t TEC_Core_VoterLocal(TEC_Core_Voter_t *Voter, uint32_t Epoch, uint32_t Raw);
+
+/**
+ * \brief Take the sample of a replica exchange packet
+ *
+ * Duplicate and late packets are dropped before they reach the epochs. A
+ * sample without TEC_CORE_QUALITY_VALID marks the replica unhealthy and
+ * is not voted on.
+ *
+ * \param[in]  Voter   Vote state
+ * \param[in]  Replica Replica index, from TEC_Core_VoterLookup
+ * \param[in]  SeqCnt  Packet sequence count
+ * \param[in]  Sample  Sample of the packet
+ * \param[out] Missed  Packets skipped, for TEC_CORE_SEQ_GAP; 0 otherwise
+ *
+ * \return Place of the packet in the replica's stream
+ */
+TEC_Core_SeqClass_t TEC_Core_VoterRemote(TEC_Core_Voter_t *Voter, uint8_t Replica, uint16_t SeqCnt,
+                                         const TEC_Core_ExchangeSample_t *Sample, uint32_t *Missed);
+
+/**
+ * \brief Record whether the local sensor could be read
+ */
+void TEC_Core_VoterLocalHealthy(TEC_Core_Voter_t *Voter, bool Healthy);
+
+/**
+ * \brief Take the oldest epoch that is ready to be voted on
+ *
+ * Only the active voters are waited for, so a dead or masked node never
+ * holds up a vote.
+ *
+ * \param[in]  Voter Vote state
+ * \param[in]  Now   Current epoch
+ * \param[out] Slot  Epoch taken, when true is returned
+ *
+ * \return true if an epoch was taken, false if none is ready
+ */
+bool TEC_Core_VoterNext(TEC_Core_Voter_t *Voter, uint32_t Now, TEC_Core_EpochSlot_t *Slot);
+
+/**
+ * \brief Vote on an epoch taken by TEC_Core_VoterNext
+ *
+ * Masked voters do not vote; their values are only checked against the
+ * result for reintegration.
+ *
+ * \param[in]  Voter  Vote state
+ * \param[in]  Slot   Epoch to vote on
+ * \param[out] Report What the vote came to, when true is returned
+ *
+ * \return false if no active voter reported for the epoch
+ */
+bool TEC_Core_VoterVote(TEC_Core_Voter_t *Voter, const TEC_Core_EpochSlot_t *Slot, TEC_Core_VoteReport_t *Report);
+
+/**
+ * \brief Mask stale and losing voters and bring back recovered ones, once per health window
+ *
+ * \param[in]  Voter        Vote state
+ * \param[in]  Now          Current epoch
+ * \param[out] Masked       Voters masked by this window
+ * \param[out] Reintegrated Voters made active again by this window
+ * \param[out] Seen         Voters that reported in this window
+ *
+ * \return true if a window was closed
+ */
+bool TEC_Core_VoterHealthUpdate(TEC_Core_Voter_t *Voter, uint32_t Now, uint32_t *Masked, uint32_t *Reintegrated,
+                                uint32_t *Seen);
+
+#endif /* TEC_CORE_VOTER_H */
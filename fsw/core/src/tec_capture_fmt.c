@@ -0,0 +1,240 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the TEC capture file byte order
+ *   and vote state records.
+ */
+
+/*
+** Include Files:
+*/
+#include <string.h>
+
+#include "tec_capture_fmt.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Convert between host byte order and little endian               */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint32_t TEC_Core_CaptureLE32(uint32_t Value)
+{
+    uint8_t  Byte[4];
+    uint32_t Result;
+
+    Byte[0] = (uint8_t)Value;
+    Byte[1] = (uint8_t)(Value >> 8);
+    Byte[2] = (uint8_t)(Value >> 16);
+    Byte[3] = (uint8_t)(Value >> 24);
+    memcpy(&Result, Byte, sizeof(Result));
+
+    return Result;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* File header flags for this host                                 */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint32_t TEC_Core_CaptureFlags(void)
+{
+    /* Only a big endian host changes the value */
+    return (TEC_Core_CaptureLE32(1) != 1) ? TEC_CAPTURE_FLAG_BIG_ENDIAN : 0;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Write the vote state into a record                              */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_Core_CaptureVoterSave(const TEC_Core_Voter_t *Voter, TEC_CaptureVoter_t *Record)
+{
+    const TEC_Core_Health_t      *Health = &Voter->Health;
+    const TEC_Core_EpochBuffer_t *Epochs = &Voter->Epochs;
+    const TEC_Core_VoterStats_t  *Stats  = &Voter->Stats;
+    uint32_t                      i;
+    uint32_t                      j;
+
+    memset(Record, 0, sizeof(*Record));
+
+    Record->Mode      = TEC_Core_CaptureLE32(Voter->Config.Mode);
+    Record->Tolerance = TEC_Core_CaptureLE32(Voter->Config.Tolerance);
+    for (i = 0; i < TEC_CORE_VOTER_MAX; ++i)
+    {
+        Record->Weight[i] = TEC_Core_CaptureLE32(Voter->Config.Weight[i]);
+    }
+    Record->MinVoters      = TEC_Core_CaptureLE32(Voter->Config.MinVoters);
+    Record->DeadlineEpochs = TEC_Core_CaptureLE32(Voter->Config.DeadlineEpochs);
+    Record->HealthWindow   = TEC_Core_CaptureLE32(Voter->Config.HealthWindow);
+    Record->Unit           = TEC_Core_CaptureLE32((uint8_t)Voter->Unit);
+
+    Record->ReplicaCount = TEC_Core_CaptureLE32(Voter->ReplicaCount);
+    for (i = 0; i < Voter->ReplicaCount && i < TEC_CORE_VOTER_REPLICAS; ++i)
+    {
+        Record->ReplicaId[i]          = TEC_Core_CaptureLE32(Voter->ReplicaId[i]);
+        Record->ReplicaSeq[i].Last    = TEC_Core_CaptureLE32(Voter->ReplicaSeq[i].Last);
+        Record->ReplicaSeq[i].Valid   = TEC_Core_CaptureLE32(Voter->ReplicaSeq[i].Valid);
+        Record->ReplicaSeq[i].Missing = TEC_Core_CaptureLE32(Voter->ReplicaSeq[i].Missing);
+    }
+
+    Record->Configured  = TEC_Core_CaptureLE32(Health->Configured);
+    Record->Active      = TEC_Core_CaptureLE32(Health->Active);
+    Record->Probation   = TEC_Core_CaptureLE32(Health->Probation);
+    Record->Seen        = TEC_Core_CaptureLE32(Health->Seen);
+    Record->Voted       = TEC_Core_CaptureLE32(Health->Voted);
+    Record->Agreed      = TEC_Core_CaptureLE32(Health->Agreed);
+    Record->Checked     = TEC_Core_CaptureLE32(Health->Checked);
+    Record->Disagreed   = TEC_Core_CaptureLE32(Health->Disagreed);
+    Record->WindowStart = TEC_Core_CaptureLE32(Health->WindowStart);
+    Record->WindowOpen  = TEC_Core_CaptureLE32(Health->WindowOpen);
+    Record->HealthyMask = TEC_Core_CaptureLE32(Voter->HealthyMask);
+
+    Record->Temperature    = TEC_Core_CaptureLE32(Voter->Temperature);
+    Record->VotedEpoch     = TEC_Core_CaptureLE32(Voter->VotedEpoch);
+    Record->AgreeMask      = TEC_Core_CaptureLE32(Voter->AgreeMask);
+    Record->LocalVotesLost = TEC_Core_CaptureLE32(Voter->LocalVotesLost);
+    Record->VoteValid      = TEC_Core_CaptureLE32(Voter->VoteValid);
+
+    for (i = 0; i < TEC_CORE_EPOCH_SLOTS; ++i)
+    {
+        Record->Slot[i].Epoch   = TEC_Core_CaptureLE32(Epochs->Slot[i].Epoch);
+        Record->Slot[i].Present = TEC_Core_CaptureLE32(Epochs->Slot[i].Present);
+        for (j = 0; j < TEC_CORE_EPOCH_VOTERS; ++j)
+        {
+            Record->Slot[i].Value[j] = TEC_Core_CaptureLE32(Epochs->Slot[i].Value[j]);
+        }
+    }
+    Record->LastVoted = TEC_Core_CaptureLE32(Epochs->LastVoted);
+    Record->HaveVoted = TEC_Core_CaptureLE32(Epochs->HaveVoted);
+
+    Record->EpochsVoted       = TEC_Core_CaptureLE32(Stats->EpochsVoted);
+    Record->EpochsIncomplete  = TEC_Core_CaptureLE32(Stats->EpochsIncomplete);
+    Record->EpochSamplesLate  = TEC_Core_CaptureLE32(Stats->EpochSamplesLate);
+    Record->EpochsEvicted     = TEC_Core_CaptureLE32(Stats->EpochsEvicted);
+    Record->ReplicaSuperseded = TEC_Core_CaptureLE32(Stats->ReplicaSuperseded);
+    for (i = 0; i < TEC_CORE_VOTER_REPLICAS; ++i)
+    {
+        Record->Link[i].Accepted   = TEC_Core_CaptureLE32(Stats->Replica[i].Accepted);
+        Record->Link[i].Lost       = TEC_Core_CaptureLE32(Stats->Replica[i].Lost);
+        Record->Link[i].Gaps       = TEC_Core_CaptureLE32(Stats->Replica[i].Gaps);
+        Record->Link[i].Duplicates = TEC_Core_CaptureLE32(Stats->Replica[i].Duplicates);
+        Record->Link[i].Late       = TEC_Core_CaptureLE32(Stats->Replica[i].Late);
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Rebuild the vote state from a record                            */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool TEC_Core_CaptureVoterLoad(TEC_Core_Voter_t *Voter, const TEC_CaptureVoter_t *Record)
+{
+    TEC_Core_VoterConfig_t  Config;
+    TEC_Core_Health_t      *Health = &Voter->Health;
+    TEC_Core_EpochBuffer_t *Epochs = &Voter->Epochs;
+    TEC_Core_VoterStats_t  *Stats  = &Voter->Stats;
+    uint32_t                ReplicaId[TEC_CORE_VOTER_REPLICAS];
+    uint32_t                Count = TEC_Core_CaptureLE32(Record->ReplicaCount);
+    uint32_t                i;
+    uint32_t                j;
+
+    TEC_Core_VoterInit(Voter);
+
+    if (Count > TEC_CORE_VOTER_REPLICAS)
+    {
+        return false;
+    }
+
+    Config.Mode      = TEC_Core_CaptureLE32(Record->Mode);
+    Config.Tolerance = TEC_Core_CaptureLE32(Record->Tolerance);
+    for (i = 0; i < TEC_CORE_VOTER_MAX; ++i)
+    {
+        Config.Weight[i] = TEC_Core_CaptureLE32(Record->Weight[i]);
+    }
+    Config.MinVoters      = TEC_Core_CaptureLE32(Record->MinVoters);
+    Config.DeadlineEpochs = TEC_Core_CaptureLE32(Record->DeadlineEpochs);
+    Config.HealthWindow   = TEC_Core_CaptureLE32(Record->HealthWindow);
+
+    /* Same calls as a table load, so the strategy and the replica map are this host's own */
+    if (!TEC_Core_VoterConfigure(Voter, &Config))
+    {
+        return false;
+    }
+    Voter->Unit = (char)TEC_Core_CaptureLE32(Record->Unit);
+
+    for (i = 0; i < Count; ++i)
+    {
+        ReplicaId[i] = TEC_Core_CaptureLE32(Record->ReplicaId[i]);
+    }
+    TEC_Core_VoterSetMembers(Voter, ReplicaId, Count);
+
+    for (i = 0; i < Count; ++i)
+    {
+        Voter->ReplicaSeq[i].Last    = (uint16_t)TEC_Core_CaptureLE32(Record->ReplicaSeq[i].Last);
+        Voter->ReplicaSeq[i].Valid   = TEC_Core_CaptureLE32(Record->ReplicaSeq[i].Valid) != 0;
+        Voter->ReplicaSeq[i].Missing = TEC_Core_CaptureLE32(Record->ReplicaSeq[i].Missing);
+    }
+
+    Health->Configured  = TEC_Core_CaptureLE32(Record->Configured);
+    Health->Active      = TEC_Core_CaptureLE32(Record->Active);
+    Health->Probation   = TEC_Core_CaptureLE32(Record->Probation);
+    Health->Seen        = TEC_Core_CaptureLE32(Record->Seen);
+    Health->Voted       = TEC_Core_CaptureLE32(Record->Voted);
+    Health->Agreed      = TEC_Core_CaptureLE32(Record->Agreed);
+    Health->Checked     = TEC_Core_CaptureLE32(Record->Checked);
+    Health->Disagreed   = TEC_Core_CaptureLE32(Record->Disagreed);
+    Health->WindowStart = TEC_Core_CaptureLE32(Record->WindowStart);
+    Health->WindowOpen  = TEC_Core_CaptureLE32(Record->WindowOpen) != 0;
+    Voter->HealthyMask  = TEC_Core_CaptureLE32(Record->HealthyMask);
+
+    Voter->Temperature    = TEC_Core_CaptureLE32(Record->Temperature);
+    Voter->VotedEpoch     = TEC_Core_CaptureLE32(Record->VotedEpoch);
+    Voter->AgreeMask      = TEC_Core_CaptureLE32(Record->AgreeMask);
+    Voter->LocalVotesLost = TEC_Core_CaptureLE32(Record->LocalVotesLost);
+    Voter->VoteValid      = TEC_Core_CaptureLE32(Record->VoteValid) != 0;
+
+    for (i = 0; i < TEC_CORE_EPOCH_SLOTS; ++i)
+    {
+        Epochs->Slot[i].Epoch   = TEC_Core_CaptureLE32(Record->Slot[i].Epoch);
+        Epochs->Slot[i].Present = TEC_Core_CaptureLE32(Record->Slot[i].Present);
+        for (j = 0; j < TEC_CORE_EPOCH_VOTERS; ++j)
+        {
+            Epochs->Slot[i].Value[j] = TEC_Core_CaptureLE32(Record->Slot[i].Value[j]);
+        }
+    }
+    Epochs->LastVoted = TEC_Core_CaptureLE32(Record->LastVoted);
+    Epochs->HaveVoted = TEC_Core_CaptureLE32(Record->HaveVoted) != 0;
+
+    Stats->EpochsVoted       = TEC_Core_CaptureLE32(Record->EpochsVoted);
+    Stats->EpochsIncomplete  = TEC_Core_CaptureLE32(Record->EpochsIncomplete);
+    Stats->EpochSamplesLate  = TEC_Core_CaptureLE32(Record->EpochSamplesLate);
+    Stats->EpochsEvicted     = TEC_Core_CaptureLE32(Record->EpochsEvicted);
+    Stats->ReplicaSuperseded = TEC_Core_CaptureLE32(Record->ReplicaSuperseded);
+    for (i = 0; i < TEC_CORE_VOTER_REPLICAS; ++i)
+    {
+        Stats->Replica[i].Accepted   = TEC_Core_CaptureLE32(Record->Link[i].Accepted);
+        Stats->Replica[i].Lost       = TEC_Core_CaptureLE32(Record->Link[i].Lost);
+        Stats->Replica[i].Gaps       = TEC_Core_CaptureLE32(Record->Link[i].Gaps);
+        Stats->Replica[i].Duplicates = TEC_Core_CaptureLE32(Record->Link[i].Duplicates);
+        Stats->Replica[i].Late       = TEC_Core_CaptureLE32(Record->Link[i].Late);
+    }
+
+    return true;
+}
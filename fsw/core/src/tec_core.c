@@ -0,0 +1,233 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the TEC core library.
+ */
+
+/*
+** Include Files:
+*/
+#include <stddef.h>
+
+#include "tec_core.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* "Read" the temperature sensor                                   */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint32_t TEC_Core_ReadRawSensor(void)
+{
+    /* Simulated sensor, gives a value between 0 and 255 */
+    // return rand() % 256;
+    return 55;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Convert a raw sample to the requested unit                      */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool TEC_Core_ConvertTemperature(uint32_t Raw, char Unit, uint32_t *Converted)
+{
+    bool Valid = true;
+
+    if (Unit == TEC_CORE_UNIT_CELSIUS)
+    {
+        *Converted = Raw;
+    }
+    else if (Unit == TEC_CORE_UNIT_FAHRENHEIT)
+    {
+        // Note: could to a sanity check for the value to be in range
+        *Converted = Raw * 2 + 32;
+    }
+    else
+    {
+        *Converted = Raw;
+        Valid      = false;
+    }
+
+    return Valid;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Majority vote, local value first                                */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+TEC_Core_VoteOutcome_t TEC_Core_MajorityVote(const uint32_t *Values, uint32_t Count, uint32_t *Voted,
+                                             uint32_t *AgreeMask)
+{
+    uint32_t Candidate = 0;
+    uint32_t Lead      = 0;
+    uint32_t Matches   = 0;
+    uint32_t Mask      = 0;
+    uint32_t i;
+
+    /*
+    ** Boyer-Moore majority vote: the first pass finds the only value that
+    ** can hold a majority, the second pass checks that it really does
+    */
+    for (i = 0; i < Count; ++i)
+    {
+        if (Lead == 0)
+        {
+            Candidate = Values[i];
+            Lead      = 1;
+        }
+        else if (Values[i] == Candidate)
+        {
+            ++Lead;
+        }
+        else
+        {
+            --Lead;
+        }
+    }
+
+    for (i = 0; i < Count; ++i)
+    {
+        if (Values[i] == Candidate)
+        {
+            ++Matches;
+            if (i < TEC_CORE_VOTE_MASK_BITS)
+            {
+                Mask |= (uint32_t)1 << i;
+            }
+        }
+    }
+
+    if (Matches <= Count / 2)
+    {
+        Mask = 0;
+    }
+
+    if (AgreeMask != NULL)
+    {
+        *AgreeMask = Mask;
+    }
+
+    if (Matches <= Count / 2)
+    {
+        return TEC_CORE_VOTE_NO_MAJORITY;
+    }
+
+    *Voted = Candidate;
+    return (Values[0] == Candidate) ? TEC_CORE_VOTE_AGREED : TEC_CORE_VOTE_OUTVOTED;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Packets skipped between two sequence counts                     */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint32_t TEC_Core_SequenceGap(uint16_t Last, uint16_t Now)
+{
+    uint32_t Step = ((uint32_t)Now - (uint32_t)Last) & (TEC_CORE_SEQ_MODULUS - 1);
+
+    if (Step == 0 || Step >= TEC_CORE_SEQ_MODULUS / 2)
+    {
+        return 0;
+    }
+
+    return Step - 1;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Next instant of the shared sampling grid                        */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint64_t TEC_Core_NextAlignedUsec(uint64_t NowUsec, uint32_t PeriodMsec, uint32_t PhaseMsec)
+{
+    uint64_t Period = (uint64_t)PeriodMsec * 1000;
+    uint64_t Phase  = (uint64_t)PhaseMsec * 1000;
+    uint64_t Base;
+
+    /* Start of the period holding NowUsec - Phase, then one period on if that is not after now */
+    Base = (NowUsec >= Phase) ? ((NowUsec - Phase) / Period) * Period + Phase : Phase;
+    if (Base <= NowUsec)
+    {
+        Base += Period;
+    }
+
+    return Base;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Duplicate, late and lost packets of one stream                  */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+TEC_Core_SeqClass_t TEC_Core_SequenceTrack(TEC_Core_SeqTracker_t *Tracker, uint16_t Now, uint32_t *Missed)
+{
+    uint32_t Step = ((uint32_t)Now - (uint32_t)Tracker->Last) & (TEC_CORE_SEQ_MODULUS - 1);
+    uint32_t Back;
+    uint32_t Bit;
+
+    *Missed = 0;
+
+    /* First packet, or a count too far behind to be a late one: the sender restarted */
+    if (!Tracker->Valid || (Step >= TEC_CORE_SEQ_MODULUS / 2 && TEC_CORE_SEQ_MODULUS - Step > 32))
+    {
+        Tracker->Last    = Now;
+        Tracker->Valid   = true;
+        Tracker->Missing = 0;
+        return TEC_CORE_SEQ_NEXT;
+    }
+
+    if (Step == 0)
+    {
+        return TEC_CORE_SEQ_DUPLICATE;
+    }
+
+    if (Step < TEC_CORE_SEQ_MODULUS / 2)
+    {
+        /* Bit i now stands for Last - 1 - i: shift by the step, mark the skipped counts */
+        *Missed = Step - 1;
+        if (Step > 32)
+        {
+            Tracker->Missing = 0xFFFFFFFFU;
+        }
+        else if (Step == 32)
+        {
+            /* A 32 bit shift is undefined; only the old Last, now bit 31, was received */
+            Tracker->Missing = ((uint32_t)1 << (Step - 1)) - 1;
+        }
+        else
+        {
+            Tracker->Missing = (Tracker->Missing << Step) | (((uint32_t)1 << (Step - 1)) - 1);
+        }
+        Tracker->Last = Now;
+
+        return (Step == 1) ? TEC_CORE_SEQ_NEXT : TEC_CORE_SEQ_GAP;
+    }
+
+    /* At most 32 behind the newest packet: late if it was still missing */
+    Back = TEC_CORE_SEQ_MODULUS - Step;
+    Bit  = (uint32_t)1 << (Back - 1);
+    if (Tracker->Missing & Bit)
+    {
+        Tracker->Missing &= ~Bit;
+        return TEC_CORE_SEQ_LATE;
+    }
+
+    return TEC_CORE_SEQ_DUPLICATE;
+}
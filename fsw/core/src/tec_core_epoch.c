@@ -0,0 +1,197 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the TEC core epoch slot buffer.
+ */
+
+/*
+** Include Files:
+*/
+#include <string.h>
+
+#include "tec_core_epoch.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Number of voters present in a slot                              */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static uint32_t TEC_Core_EpochVoters(uint32_t Present)
+{
+    uint32_t Count = 0;
+
+    while (Present != 0)
+    {
+        Present &= Present - 1;
+        ++Count;
+    }
+
+    return Count;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* True if epoch A comes before epoch B, across the wrap           */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static inline bool TEC_Core_EpochBefore(uint32_t A, uint32_t B)
+{
+    return (int32_t)(A - B) < 0;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Epoch of a time                                                 */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint32_t TEC_Core_EpochOf(uint32_t Seconds, uint32_t Subseconds, uint32_t PeriodMsec)
+{
+    uint64_t Msec = (uint64_t)Seconds * 1000 + (((uint64_t)Subseconds * 1000) >> 32);
+
+    return (uint32_t)(Msec / PeriodMsec);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Empty the buffer                                                */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_Core_EpochInit(TEC_Core_EpochBuffer_t *Buffer)
+{
+    memset(Buffer, 0, sizeof(*Buffer));
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Store one voter's value for an epoch                            */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+TEC_Core_EpochStore_t TEC_Core_EpochStore(TEC_Core_EpochBuffer_t *Buffer, uint32_t Epoch, uint32_t Voter,
+                                          uint32_t Value, uint32_t MinVoters)
+{
+    TEC_Core_EpochSlot_t *Slot   = &Buffer->Slot[Epoch & (TEC_CORE_EPOCH_SLOTS - 1)];
+    TEC_Core_EpochStore_t Result = TEC_CORE_EPOCH_STORED;
+    uint32_t              Bit    = (uint32_t)1 << Voter;
+
+    if (Buffer->HaveVoted && !TEC_Core_EpochBefore(Buffer->LastVoted, Epoch))
+    {
+        return TEC_CORE_EPOCH_LATE;
+    }
+
+    if (Slot->Present != 0 && Slot->Epoch != Epoch)
+    {
+        /* The slot still holds an epoch a whole buffer length away; keep the newer one */
+        if (TEC_Core_EpochBefore(Epoch, Slot->Epoch))
+        {
+            return TEC_CORE_EPOCH_LATE;
+        }
+
+        if (TEC_Core_EpochVoters(Slot->Present) >= MinVoters)
+        {
+            Result = TEC_CORE_EPOCH_EVICTED;
+        }
+        Slot->Present = 0;
+    }
+
+    if (Slot->Present & Bit)
+    {
+        Result = TEC_CORE_EPOCH_SUPERSEDED;
+    }
+
+    Slot->Epoch        = Epoch;
+    Slot->Value[Voter] = Value;
+    Slot->Present |= Bit;
+
+    return Result;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Take the oldest epoch that is complete or past its deadline     */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool TEC_Core_EpochNext(TEC_Core_EpochBuffer_t *Buffer, uint32_t Now, uint32_t DeadlineEpochs, uint32_t ActiveMask,
+                        uint32_t MinVoters, TEC_Core_EpochSlot_t *Slot)
+{
+    TEC_Core_EpochSlot_t *Oldest;
+    uint32_t              Round;
+    uint32_t              i;
+
+    /* Every round either returns or frees one slot */
+    for (Round = 0; Round < TEC_CORE_EPOCH_SLOTS; ++Round)
+    {
+        Oldest = NULL;
+        for (i = 0; i < TEC_CORE_EPOCH_SLOTS; ++i)
+        {
+            if (Buffer->Slot[i].Present != 0 &&
+                (Oldest == NULL || TEC_Core_EpochBefore(Buffer->Slot[i].Epoch, Oldest->Epoch)))
+            {
+                Oldest = &Buffer->Slot[i];
+            }
+        }
+
+        if (Oldest == NULL || ((Oldest->Present & ActiveMask) != ActiveMask &&
+                               TEC_Core_EpochBefore(Now - DeadlineEpochs, Oldest->Epoch)))
+        {
+            return false;
+        }
+
+        Buffer->LastVoted = Oldest->Epoch;
+        Buffer->HaveVoted = true;
+
+        /* Masked voters are only checked against the result, they do not make up the numbers */
+        if (TEC_Core_EpochVoters(Oldest->Present & ActiveMask) >= MinVoters)
+        {
+            *Slot           = *Oldest;
+            Oldest->Present = 0;
+            return true;
+        }
+
+        Oldest->Present = 0;
+    }
+
+    return false;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Carry on from an epoch voted on elsewhere                       */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_Core_EpochResume(TEC_Core_EpochBuffer_t *Buffer, uint32_t LastVoted)
+{
+    uint32_t i;
+
+    if (Buffer->HaveVoted && !TEC_Core_EpochBefore(Buffer->LastVoted, LastVoted))
+    {
+        return;
+    }
+
+    for (i = 0; i < TEC_CORE_EPOCH_SLOTS; ++i)
+    {
+        if (Buffer->Slot[i].Present != 0 && !TEC_Core_EpochBefore(LastVoted, Buffer->Slot[i].Epoch))
+        {
+            Buffer->Slot[i].Present = 0;
+        }
+    }
+
+    Buffer->LastVoted = LastVoted;
+    Buffer->HaveVoted = true;
+}
@@ -0,0 +1,150 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the TEC core fusion kernels.
+ */
+
+/*
+** Include Files:
+*/
+#include <stddef.h>
+
+#include "tec_core_fusion.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Absolute difference of two unsigned values                      */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static inline uint32_t TEC_Core_Distance(uint32_t A, uint32_t B)
+{
+    return (A > B) ? A - B : B - A;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Majority vote with a tolerance band                             */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+TEC_Core_VoteOutcome_t TEC_Core_ToleranceMajorityVote(const uint32_t *Values, uint32_t Count, uint32_t Tolerance,
+                                                      uint32_t *Voted, uint32_t *AgreeMask)
+{
+    uint32_t Best        = 0;
+    uint32_t BestMatches = 0;
+    uint32_t Matches;
+    uint32_t i;
+    uint32_t j;
+
+    for (i = 0; i < Count; ++i)
+    {
+        Matches = 0;
+        for (j = 0; j < Count; ++j)
+        {
+            Matches += (uint32_t)(TEC_Core_Distance(Values[i], Values[j]) <= Tolerance);
+        }
+
+        if (Matches > BestMatches)
+        {
+            Best        = i;
+            BestMatches = Matches;
+        }
+    }
+
+    return TEC_Core_ToleranceVote(Values, Count, Tolerance, Values[Best], Voted, AgreeMask);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Weighted average with a tolerance band                          */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+TEC_Core_VoteOutcome_t TEC_Core_WeightedAverageVote(const uint32_t *Values, const uint32_t *Weights, uint32_t Count,
+                                                    uint32_t Tolerance, uint32_t *Voted, uint32_t *AgreeMask)
+{
+    uint64_t Sum         = 0;
+    uint64_t TotalWeight = 0;
+    uint32_t i;
+
+    /* 16 bit weights times 32 bit values: TEC_CORE_SORT_MAX terms cannot overflow 64 bits */
+    for (i = 0; i < Count; ++i)
+    {
+        Sum += (uint64_t)Values[i] * Weights[i];
+        TotalWeight += Weights[i];
+    }
+
+    if (TotalWeight == 0)
+    {
+        if (AgreeMask != NULL)
+        {
+            *AgreeMask = 0;
+        }
+        return TEC_CORE_VOTE_NO_MAJORITY;
+    }
+
+    return TEC_Core_ToleranceVote(Values, Count, Tolerance, (uint32_t)((Sum + TotalWeight / 2) / TotalWeight), Voted,
+                                  AgreeMask);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* First healthy replica                                           */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+TEC_Core_VoteOutcome_t TEC_Core_FirstHealthyVote(const uint32_t *Values, uint32_t Count, uint32_t HealthyMask,
+                                                 uint32_t Tolerance, uint32_t *Voted, uint32_t *AgreeMask)
+{
+    uint32_t Mask = 0;
+    uint32_t Selected;
+    uint32_t i;
+
+    for (i = 0; i < Count; ++i)
+    {
+        if (HealthyMask & ((uint32_t)1 << i))
+        {
+            break;
+        }
+    }
+
+    if (i == Count)
+    {
+        if (AgreeMask != NULL)
+        {
+            *AgreeMask = 0;
+        }
+        return TEC_CORE_VOTE_NO_MAJORITY;
+    }
+
+    Selected = Values[i];
+    for (i = 0; i < Count; ++i)
+    {
+        if ((HealthyMask & ((uint32_t)1 << i)) && TEC_Core_Distance(Values[i], Selected) <= Tolerance)
+        {
+            Mask |= (uint32_t)1 << i;
+        }
+    }
+
+    if (AgreeMask != NULL)
+    {
+        *AgreeMask = Mask;
+    }
+
+    *Voted = Selected;
+    return (Mask & 1) ? TEC_CORE_VOTE_AGREED : TEC_CORE_VOTE_OUTVOTED;
+}
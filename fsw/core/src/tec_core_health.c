@@ -0,0 +1,147 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the TEC core voter health tracking.
+ */
+
+/*
+** Include Files:
+*/
+#include <string.h>
+
+#include "tec_core_health.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Start tracking a new membership                                 */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_Core_HealthInit(TEC_Core_Health_t *Health, uint32_t Configured)
+{
+    memset(Health, 0, sizeof(*Health));
+
+    Health->Configured = Configured;
+    Health->Active     = Configured;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* A voter reported                                                */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_Core_HealthSeen(TEC_Core_Health_t *Health, uint32_t Voter)
+{
+    Health->Seen |= (uint32_t)1 << Voter;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* A vote reached a majority                                       */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_Core_HealthVote(TEC_Core_Health_t *Health, uint32_t Voters, uint32_t AgreeMask, uint32_t Shadow,
+                         uint32_t ShadowOk)
+{
+    Health->Voted |= Voters;
+    Health->Agreed |= AgreeMask;
+    Health->Checked |= Shadow;
+    Health->Disagreed |= Shadow & ~ShadowOk;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Judge the voters at the end of a health window                  */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool TEC_Core_HealthUpdate(TEC_Core_Health_t *Health, uint32_t Now, uint32_t Window, uint32_t *Masked,
+                           uint32_t *Reintegrated)
+{
+    uint32_t Bad;
+    uint32_t Clean;
+    uint32_t Active;
+    uint32_t Probation;
+
+    *Masked       = 0;
+    *Reintegrated = 0;
+
+    if (!Health->WindowOpen)
+    {
+        Health->WindowStart = Now;
+        Health->WindowOpen  = true;
+        return false;
+    }
+
+    if (Now - Health->WindowStart < Window)
+    {
+        return false;
+    }
+
+    /* Stale: did not report at all. Losing: voted and never agreed. */
+    Bad = Health->Active & (~Health->Seen | (Health->Voted & ~Health->Agreed));
+
+    /* An inactive voter is clean if it reported, was checked and always agreed */
+    Clean = Health->Configured & ~Health->Active & Health->Seen & Health->Checked & ~Health->Disagreed;
+
+    Active    = (Health->Active & ~Bad) | (Health->Probation & Clean);
+    Probation = Clean & ~Health->Probation;
+
+    /* Never mask the last voter; simplex is the floor */
+    if (Active == 0)
+    {
+        Active = Health->Active;
+    }
+
+    *Masked       = Health->Active & ~Active;
+    *Reintegrated = Active & ~Health->Active;
+
+    Health->Active      = Active;
+    Health->Probation   = Probation;
+    Health->Seen        = 0;
+    Health->Voted       = 0;
+    Health->Agreed      = 0;
+    Health->Checked     = 0;
+    Health->Disagreed   = 0;
+    Health->WindowStart = Now;
+
+    return true;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Take over voter states judged elsewhere                         */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_Core_HealthRestore(TEC_Core_Health_t *Health, uint32_t Known, uint32_t Active, uint32_t Probation)
+{
+    uint32_t NewActive;
+
+    Known &= Health->Configured;
+    Active &= Known;
+    Probation &= Known & ~Active;
+
+    NewActive = (Health->Active & ~Known) | Active;
+    if (NewActive == 0)
+    {
+        return;
+    }
+
+    Health->Active    = NewActive;
+    Health->Probation = (Health->Probation & ~Known) | Probation;
+}
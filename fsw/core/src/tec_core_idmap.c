@@ -0,0 +1,114 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the TEC core key to index map.
+ */
+
+/*
+** Include Files:
+*/
+#include <string.h>
+
+#include "tec_core_idmap.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Home slot of a key (Fibonacci hashing)                          */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static uint32_t TEC_Core_IdMapHash(uint32_t Key)
+{
+    return (Key * 2654435769U) >> (32 - TEC_CORE_IDMAP_SLOTS_LOG2);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Remove all entries                                              */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_Core_IdMapInit(TEC_Core_IdMap_t *Map)
+{
+    memset(Map, 0, sizeof(*Map));
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Add a key                                                       */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool TEC_Core_IdMapInsert(TEC_Core_IdMap_t *Map, uint32_t Key, uint8_t Value)
+{
+    uint32_t Slot = TEC_Core_IdMapHash(Key);
+    uint32_t Probe;
+
+    if (Key == 0)
+    {
+        return false;
+    }
+
+    for (Probe = 0; Probe < TEC_CORE_IDMAP_SLOTS; ++Probe)
+    {
+        if (Map->Key[Slot] == Key)
+        {
+            return false;
+        }
+
+        if (Map->Key[Slot] == 0)
+        {
+            Map->Key[Slot]   = Key;
+            Map->Value[Slot] = Value;
+            return true;
+        }
+
+        Slot = (Slot + 1) & (TEC_CORE_IDMAP_SLOTS - 1);
+    }
+
+    return false;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Find the index stored with a key                                */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool TEC_Core_IdMapLookup(const TEC_Core_IdMap_t *Map, uint32_t Key, uint8_t *Value)
+{
+    uint32_t Slot = TEC_Core_IdMapHash(Key);
+    uint32_t Probe;
+
+    if (Key == 0)
+    {
+        return false;
+    }
+
+    /* Entries are never removed one by one, so the first empty slot ends the probe */
+    for (Probe = 0; Probe < TEC_CORE_IDMAP_SLOTS && Map->Key[Slot] != 0; ++Probe)
+    {
+        if (Map->Key[Slot] == Key)
+        {
+            *Value = Map->Value[Slot];
+            return true;
+        }
+
+        Slot = (Slot + 1) & (TEC_CORE_IDMAP_SLOTS - 1);
+    }
+
+    return false;
+}
@@ -0,0 +1,244 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the TEC core median voting kernels.
+ */
+
+/*
+** Include Files:
+*/
+#include <stddef.h>
+#include <string.h>
+
+#include "tec_core_median.h"
+
+/*
+** Comparator lists of the sorting networks for 2 to TEC_CORE_NETWORK_MAX
+** inputs, each pair (i, j) with i < j. Sizes are the known optimum for
+** each input count.
+*/
+typedef struct
+{
+    uint8_t Lo;
+    uint8_t Hi;
+} TEC_Core_Comparator_t;
+
+static const TEC_Core_Comparator_t TEC_Core_Network2[] = {{0, 1}};
+
+static const TEC_Core_Comparator_t TEC_Core_Network3[] = {{0, 2}, {0, 1}, {1, 2}};
+
+static const TEC_Core_Comparator_t TEC_Core_Network4[] = {{0, 2}, {1, 3}, {0, 1}, {2, 3}, {1, 2}};
+
+static const TEC_Core_Comparator_t TEC_Core_Network5[] = {{0, 3}, {1, 4}, {0, 2}, {1, 3}, {0, 1},
+                                                          {2, 4}, {1, 2}, {3, 4}, {2, 3}};
+
+static const TEC_Core_Comparator_t TEC_Core_Network6[] = {{0, 5}, {1, 3}, {2, 4}, {1, 2}, {3, 4}, {0, 3},
+                                                          {2, 5}, {0, 1}, {2, 3}, {4, 5}, {1, 2}, {3, 4}};
+
+static const TEC_Core_Comparator_t TEC_Core_Network7[] = {{0, 6}, {2, 3}, {4, 5}, {0, 2}, {1, 4}, {3, 6},
+                                                          {0, 1}, {2, 5}, {3, 4}, {1, 2}, {4, 6}, {2, 3},
+                                                          {4, 5}, {1, 2}, {3, 4}, {5, 6}};
+
+static const TEC_Core_Comparator_t TEC_Core_Network8[] = {{0, 2}, {1, 3}, {4, 6}, {5, 7}, {0, 4}, {1, 5}, {2, 6},
+                                                          {3, 7}, {0, 1}, {2, 3}, {4, 5}, {6, 7}, {2, 4}, {3, 5},
+                                                          {1, 4}, {3, 6}, {1, 2}, {3, 4}, {5, 6}};
+
+static const TEC_Core_Comparator_t TEC_Core_Network9[] = {
+    {0, 3}, {1, 7}, {2, 5}, {4, 8}, {0, 7}, {2, 4}, {3, 8}, {5, 6}, {0, 2}, {1, 3}, {4, 5}, {7, 8}, {1, 4},
+    {3, 6}, {5, 7}, {0, 1}, {2, 4}, {3, 5}, {6, 8}, {2, 3}, {4, 5}, {6, 7}, {1, 2}, {3, 4}, {5, 6}};
+
+#define TEC_CORE_NETWORK(n) {TEC_Core_Network##n, sizeof(TEC_Core_Network##n) / sizeof(TEC_Core_Network##n[0])}
+
+static const struct
+{
+    const TEC_Core_Comparator_t *Comparators;
+    uint32_t                     Size;
+} TEC_Core_Networks[TEC_CORE_NETWORK_MAX + 1] = {
+    {NULL, 0},             {NULL, 0},
+    TEC_CORE_NETWORK(2),   TEC_CORE_NETWORK(3),
+    TEC_CORE_NETWORK(4),   TEC_CORE_NETWORK(5),
+    TEC_CORE_NETWORK(6),   TEC_CORE_NETWORK(7),
+    TEC_CORE_NETWORK(8),   TEC_CORE_NETWORK(9),
+};
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Put two values in order without a data-dependent branch         */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static inline void TEC_Core_CompareExchange(uint32_t *Lo, uint32_t *Hi)
+{
+    uint32_t A    = *Lo;
+    uint32_t B    = *Hi;
+    uint32_t Swap = (uint32_t)0 - (uint32_t)(B < A); /* All ones if out of order */
+    uint32_t Diff = (A ^ B) & Swap;
+
+    *Lo = A ^ Diff;
+    *Hi = B ^ Diff;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Sort in place with the sorting network for Count inputs         */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_Core_SortNetwork(uint32_t *Values, uint32_t Count)
+{
+    const TEC_Core_Comparator_t *Comparator;
+    uint32_t                     Round;
+    uint32_t                     i;
+
+    if (Count <= TEC_CORE_NETWORK_MAX)
+    {
+        Comparator = TEC_Core_Networks[Count].Comparators;
+        for (i = 0; i < TEC_Core_Networks[Count].Size; ++i)
+        {
+            TEC_Core_CompareExchange(&Values[Comparator[i].Lo], &Values[Comparator[i].Hi]);
+        }
+    }
+    else
+    {
+        /* Odd-even transposition: Count rounds of alternating neighbour exchanges */
+        for (Round = 0; Round < Count; ++Round)
+        {
+            for (i = Round & 1; i + 1 < Count; i += 2)
+            {
+                TEC_Core_CompareExchange(&Values[i], &Values[i + 1]);
+            }
+        }
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Sorted copy of the replica values                               */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void TEC_Core_SortedCopy(const uint32_t *Values, uint32_t Count, uint32_t *Sorted)
+{
+    memcpy(Sorted, Values, Count * sizeof(Sorted[0]));
+    TEC_Core_SortNetwork(Sorted, Count);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Mid-value select                                                */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint32_t TEC_Core_MidValueSelect(const uint32_t *Values, uint32_t Count)
+{
+    uint32_t Sorted[TEC_CORE_SORT_MAX];
+
+    TEC_Core_SortedCopy(Values, Count, Sorted);
+
+    return Sorted[(Count - 1) / 2];
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Median                                                          */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint32_t TEC_Core_Median(const uint32_t *Values, uint32_t Count)
+{
+    uint32_t Sorted[TEC_CORE_SORT_MAX];
+    uint32_t Lo;
+    uint32_t Hi;
+
+    TEC_Core_SortedCopy(Values, Count, Sorted);
+
+    /* Same element twice for an odd count; mean without overflow otherwise */
+    Lo = Sorted[(Count - 1) / 2];
+    Hi = Sorted[Count / 2];
+
+    return Lo + (Hi - Lo) / 2;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Agreement with a voted value inside the tolerance band          */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+TEC_Core_VoteOutcome_t TEC_Core_ToleranceVote(const uint32_t *Values, uint32_t Count, uint32_t Tolerance,
+                                              uint32_t Candidate, uint32_t *Voted, uint32_t *AgreeMask)
+{
+    uint32_t Mask    = 0;
+    uint32_t Matches = 0;
+    uint32_t Agree;
+    uint32_t Lo;
+    uint32_t Hi;
+    uint32_t Swap;
+    uint32_t i;
+
+    for (i = 0; i < Count; ++i)
+    {
+        /* |Values[i] - Candidate| without a branch */
+        Lo   = Values[i];
+        Hi   = Candidate;
+        Swap = ((uint32_t)0 - (uint32_t)(Hi < Lo)) & (Lo ^ Hi);
+        Lo ^= Swap;
+        Hi ^= Swap;
+
+        Agree = (uint32_t)((Hi - Lo) <= Tolerance);
+        Matches += Agree;
+        Mask |= Agree << i;
+    }
+
+    if (Matches <= Count / 2)
+    {
+        Mask = 0;
+    }
+
+    if (AgreeMask != NULL)
+    {
+        *AgreeMask = Mask;
+    }
+
+    if (Matches <= Count / 2)
+    {
+        return TEC_CORE_VOTE_NO_MAJORITY;
+    }
+
+    *Voted = Candidate;
+    return (Mask & 1) ? TEC_CORE_VOTE_AGREED : TEC_CORE_VOTE_OUTVOTED;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Vote on the mid-value select                                    */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+TEC_Core_VoteOutcome_t TEC_Core_MidValueVote(const uint32_t *Values, uint32_t Count, uint32_t Tolerance,
+                                             uint32_t *Voted, uint32_t *AgreeMask)
+{
+    return TEC_Core_ToleranceVote(Values, Count, Tolerance, TEC_Core_MidValueSelect(Values, Count), Voted,
+                                  AgreeMask);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Vote on the median                                              */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+TEC_Core_VoteOutcome_t TEC_Core_MedianVote(const uint32_t *Values, uint32_t Count, uint32_t Tolerance,
+                                           uint32_t *Voted, uint32_t *AgreeMask)
+{
+    return TEC_Core_ToleranceVote(Values, Count, Tolerance, TEC_Core_Median(Values, Count), Voted, AgreeMask);
+}
@@ -0,0 +1,91 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the TEC core sample ring.
+ */
+
+/*
+** Include Files:
+*/
+#include <string.h>
+
+#include "tec_core_ring.h"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define TEC_CORE_LOAD_ACQUIRE(p)     __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define TEC_CORE_STORE_RELEASE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#else
+/* Aligned 32 bit accesses are atomic on every supported target; this only orders the compiler */
+#define TEC_CORE_LOAD_ACQUIRE(p)     (*(volatile const uint32_t *)(p))
+#define TEC_CORE_STORE_RELEASE(p, v) (*(volatile uint32_t *)(p) = (v))
+#endif
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Empty the ring                                                  */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_Core_RingInit(TEC_Core_SampleRing_t *Ring)
+{
+    memset(Ring, 0, sizeof(*Ring));
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Producer: append a sample                                       */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool TEC_Core_RingPush(TEC_Core_SampleRing_t *Ring, const TEC_Core_Sample_t *Sample)
+{
+    uint32_t Head = Ring->Head;
+    uint32_t Tail = TEC_CORE_LOAD_ACQUIRE(&Ring->Tail);
+
+    if ((uint32_t)(Head - Tail) >= TEC_CORE_RING_SIZE)
+    {
+        ++Ring->Overruns;
+        return false;
+    }
+
+    Ring->Slot[Head & (TEC_CORE_RING_SIZE - 1)] = *Sample;
+    TEC_CORE_STORE_RELEASE(&Ring->Head, Head + 1);
+
+    return true;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Consumer: remove the oldest sample                              */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool TEC_Core_RingPop(TEC_Core_SampleRing_t *Ring, TEC_Core_Sample_t *Sample)
+{
+    uint32_t Tail = Ring->Tail;
+    uint32_t Head = TEC_CORE_LOAD_ACQUIRE(&Ring->Head);
+
+    if (Head == Tail)
+    {
+        return false;
+    }
+
+    *Sample = Ring->Slot[Tail & (TEC_CORE_RING_SIZE - 1)];
+    TEC_CORE_STORE_RELEASE(&Ring->Tail, Tail + 1);
+
+    return true;
+}
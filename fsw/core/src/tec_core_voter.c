@@ -0,0 +1,412 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the TEC core replica vote pipeline.
+ */
+
+/*
+** Include Files:
+*/
+#include <string.h>
+
+#include "tec_core_voter.h"
+#include "tec_core_fusion.h"
+#include "tec_core_median.h"
+
+/*
+** Adapters from the kernels to TEC_Core_VoteFunc_t
+*/
+static TEC_Core_VoteOutcome_t TEC_Core_VoteMajority(const TEC_Core_VoteInput_t *Input, uint32_t *Voted,
+                                                    uint32_t *AgreeMask)
+{
+    return TEC_Core_MajorityVote(Input->Values, Input->Count, Voted, AgreeMask);
+}
+
+static TEC_Core_VoteOutcome_t TEC_Core_VoteMidValue(const TEC_Core_VoteInput_t *Input, uint32_t *Voted,
+                                                    uint32_t *AgreeMask)
+{
+    return TEC_Core_MidValueVote(Input->Values, Input->Count, Input->Tolerance, Voted, AgreeMask);
+}
+
+static TEC_Core_VoteOutcome_t TEC_Core_VoteMedian(const TEC_Core_VoteInput_t *Input, uint32_t *Voted,
+                                                  uint32_t *AgreeMask)
+{
+    return TEC_Core_MedianVote(Input->Values, Input->Count, Input->Tolerance, Voted, AgreeMask);
+}
+
+static TEC_Core_VoteOutcome_t TEC_Core_VoteToleranceMajority(const TEC_Core_VoteInput_t *Input, uint32_t *Voted,
+                                                             uint32_t *AgreeMask)
+{
+    return TEC_Core_ToleranceMajorityVote(Input->Values, Input->Count, Input->Tolerance, Voted, AgreeMask);
+}
+
+static TEC_Core_VoteOutcome_t TEC_Core_VoteWeightedAverage(const TEC_Core_VoteInput_t *Input, uint32_t *Voted,
+                                                           uint32_t *AgreeMask)
+{
+    return TEC_Core_WeightedAverageVote(Input->Values, Input->Weights, Input->Count, Input->Tolerance, Voted,
+                                        AgreeMask);
+}
+
+static TEC_Core_VoteOutcome_t TEC_Core_VoteFirstHealthy(const TEC_Core_VoteInput_t *Input, uint32_t *Voted,
+                                                        uint32_t *AgreeMask)
+{
+    return TEC_Core_FirstHealthyVote(Input->Values, Input->Count, Input->HealthyMask, Input->Tolerance, Voted,
+                                     AgreeMask);
+}
+
+static const TEC_Core_VoteFunc_t TEC_Core_VoteStrategies[TEC_CORE_VOTE_MODE_COUNT] = {
+    [TEC_CORE_VOTE_MODE_MAJORITY]           = TEC_Core_VoteMajority,
+    [TEC_CORE_VOTE_MODE_MID_VALUE]          = TEC_Core_VoteMidValue,
+    [TEC_CORE_VOTE_MODE_MEDIAN]             = TEC_Core_VoteMedian,
+    [TEC_CORE_VOTE_MODE_TOLERANCE_MAJORITY] = TEC_Core_VoteToleranceMajority,
+    [TEC_CORE_VOTE_MODE_WEIGHTED_AVERAGE]   = TEC_Core_VoteWeightedAverage,
+    [TEC_CORE_VOTE_MODE_FIRST_HEALTHY]      = TEC_Core_VoteFirstHealthy,
+};
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Voting strategy of a vote mode                                  */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+TEC_Core_VoteFunc_t TEC_Core_VoteStrategy(uint32_t Mode)
+{
+    if (Mode >= TEC_CORE_VOTE_MODE_COUNT)
+    {
+        return NULL;
+    }
+
+    return TEC_Core_VoteStrategies[Mode];
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Clear all vote state                                            */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_Core_VoterInit(TEC_Core_Voter_t *Voter)
+{
+    memset(Voter, 0, sizeof(*Voter));
+
+    Voter->Unit = TEC_CORE_UNIT_CELSIUS;
+    TEC_Core_IdMapInit(&Voter->ReplicaMap);
+    TEC_Core_EpochInit(&Voter->Epochs);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Take over new vote parameters                                   */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool TEC_Core_VoterConfigure(TEC_Core_Voter_t *Voter, const TEC_Core_VoterConfig_t *Config)
+{
+    TEC_Core_VoteFunc_t VoteFunc = TEC_Core_VoteStrategy(Config->Mode);
+
+    if (VoteFunc == NULL)
+    {
+        return false;
+    }
+
+    Voter->Config   = *Config;
+    Voter->VoteFunc = VoteFunc;
+
+    return true;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Replace the replica membership                                  */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_Core_VoterSetMembers(TEC_Core_Voter_t *Voter, const uint32_t *ReplicaId, uint32_t Count)
+{
+    uint32_t i;
+
+    Voter->ReplicaCount = 0;
+    Voter->HealthyMask &= 1; /* Remote replicas are usable again once they report */
+    TEC_Core_IdMapInit(&Voter->ReplicaMap);
+    TEC_Core_EpochInit(&Voter->Epochs);
+    memset(Voter->ReplicaSeq, 0, sizeof(Voter->ReplicaSeq));
+    memset(Voter->Stats.Replica, 0, sizeof(Voter->Stats.Replica));
+
+    for (i = 0; i < Count && i < TEC_CORE_VOTER_REPLICAS; i++)
+    {
+        TEC_Core_IdMapInsert(&Voter->ReplicaMap, ReplicaId[i], (uint8_t)Voter->ReplicaCount);
+        Voter->ReplicaId[Voter->ReplicaCount] = ReplicaId[i];
+        ++Voter->ReplicaCount;
+    }
+
+    /* Every member starts out active; health windows mask the ones that misbehave */
+    TEC_Core_HealthInit(&Voter->Health, (uint32_t)(((uint64_t)1 << (1 + Voter->ReplicaCount)) - 1));
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Replica index of an exchange message ID value                   */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool TEC_Core_VoterLookup(const TEC_Core_Voter_t *Voter, uint32_t Id, uint8_t *Replica)
+{
+    return TEC_Core_IdMapLookup(&Voter->ReplicaMap, Id, Replica);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* File a converted value under its sample epoch                   */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static TEC_Core_EpochStore_t TEC_Core_VoterStore(TEC_Core_Voter_t *Voter, uint32_t Index, uint32_t Epoch,
+                                                 uint32_t Value)
+{
+    TEC_Core_EpochStore_t Result;
+
+    Result = TEC_Core_EpochStore(&Voter->Epochs, Epoch, Index, Value, Voter->Config.MinVoters);
+    switch (Result)
+    {
+        case TEC_CORE_EPOCH_SUPERSEDED:
+            /* Only the newest value per processor and epoch is voted on */
+            if (Index != 0)
+            {
+                ++Voter->Stats.ReplicaSuperseded;
+            }
+            break;
+
+        case TEC_CORE_EPOCH_EVICTED:
+            ++Voter->Stats.EpochsEvicted;
+            break;
+
+        case TEC_CORE_EPOCH_LATE:
+            ++Voter->Stats.EpochSamplesLate;
+            break;
+
+        default:
+            break;
+    }
+
+    if (Index != 0)
+    {
+        Voter->HealthyMask |= (uint32_t)1 << Index;
+    }
+
+    TEC_Core_HealthSeen(&Voter->Health, Index);
+
+    return Result;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* File a local sample                                             */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+TEC_Core_EpochStore_t TEC_Core_VoterLocal(TEC_Core_Voter_t *Voter, uint32_t Epoch, uint32_t Raw)
+{
+    uint32_t Temperature;
+
+    /* An invalid unit falls back to Celsius */
+    TEC_Core_ConvertTemperature(Raw, Voter->Unit, &Temperature);
+
+    return TEC_Core_VoterStore(Voter, 0, Epoch, Temperature);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Take the sample of a replica exchange packet                    */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+TEC_Core_SeqClass_t TEC_Core_VoterRemote(TEC_Core_Voter_t *Voter, uint8_t Replica, uint16_t SeqCnt,
+                                         const TEC_Core_ExchangeSample_t *Sample, uint32_t *Missed)
+{
+    TEC_Core_LinkStats_t *Link = &Voter->Stats.Replica[Replica];
+    TEC_Core_SeqClass_t   Class;
+    uint32_t              Temperature;
+
+    Class = TEC_Core_SequenceTrack(&Voter->ReplicaSeq[Replica], SeqCnt, Missed);
+    switch (Class)
+    {
+        case TEC_CORE_SEQ_GAP:
+            Link->Lost += *Missed;
+            ++Link->Gaps;
+            break;
+
+        case TEC_CORE_SEQ_LATE:
+            /* Counted as lost when the gap opened; it arrived after all, too late to vote */
+            if (Link->Lost > 0)
+            {
+                --Link->Lost;
+            }
+            ++Link->Late;
+            return Class;
+
+        case TEC_CORE_SEQ_DUPLICATE:
+            ++Link->Duplicates;
+            return Class;
+
+        default:
+            break;
+    }
+
+    ++Link->Accepted;
+
+    /* A replica that cannot read its sensor has nothing to vote with; it goes stale and is masked */
+    if ((Sample->Quality & TEC_CORE_QUALITY_VALID) == 0)
+    {
+        Voter->HealthyMask &= ~((uint32_t)1 << (1 + Replica));
+        return Class;
+    }
+
+    /* Converted here, so every replica's value is in the local unit */
+    TEC_Core_ConvertTemperature(Sample->Raw, Voter->Unit, &Temperature);
+    TEC_Core_VoterStore(Voter, 1 + Replica, Sample->Epoch, Temperature);
+
+    return Class;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Record whether the local sensor could be read                   */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_Core_VoterLocalHealthy(TEC_Core_Voter_t *Voter, bool Healthy)
+{
+    if (Healthy)
+    {
+        Voter->HealthyMask |= 1U;
+    }
+    else
+    {
+        Voter->HealthyMask &= ~1U;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Take the oldest epoch that is ready to be voted on              */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool TEC_Core_VoterNext(TEC_Core_Voter_t *Voter, uint32_t Now, TEC_Core_EpochSlot_t *Slot)
+{
+    uint32_t Active = Voter->Health.Active;
+    uint32_t MinVoters;
+
+    /* Two values while two voters are active, else one; clearing the lowest bit leaves something if two are */
+    MinVoters = ((Active & (Active - 1)) != 0) ? Voter->Config.MinVoters : 1;
+
+    return TEC_Core_EpochNext(&Voter->Epochs, Now, Voter->Config.DeadlineEpochs, Active, MinVoters, Slot);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Vote on the values of one sample epoch                          */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool TEC_Core_VoterVote(TEC_Core_Voter_t *Voter, const TEC_Core_EpochSlot_t *Slot, TEC_Core_VoteReport_t *Report)
+{
+    TEC_Core_VoteInput_t Input;
+    uint8_t              Index[TEC_CORE_VOTER_MAX];
+    uint32_t             Voters;
+    uint32_t             Shadow;
+    uint32_t             ShadowOk = 0;
+    uint32_t             Complete;
+    uint32_t             Distance;
+    uint32_t             Mask = 0;
+    uint32_t             i;
+
+    /* Masked voters do not vote; their values are only checked against the result */
+    Complete = Voter->Health.Active;
+    Voters   = Slot->Present & Voter->Health.Active;
+    Shadow   = Slot->Present & Voter->Health.Configured & ~Voter->Health.Active;
+    if (Voters == 0)
+    {
+        return false;
+    }
+
+    Input.Count       = 0;
+    Input.HealthyMask = 0;
+    Input.Tolerance   = Voter->Config.Tolerance;
+    for (i = 0; i < TEC_CORE_VOTER_MAX; i++)
+    {
+        if (Voters & ((uint32_t)1 << i))
+        {
+            Index[Input.Count]         = (uint8_t)i;
+            Input.Values[Input.Count]  = Slot->Value[i];
+            Input.Weights[Input.Count] = Voter->Config.Weight[i];
+            Input.HealthyMask |= ((Voter->HealthyMask >> i) & 1U) << Input.Count;
+            ++Input.Count;
+        }
+    }
+
+    Report->Outcome    = Voter->VoteFunc(&Input, &Voter->Temperature, &Mask);
+    Report->Epoch      = Slot->Epoch;
+    Report->Voters     = Voters;
+    Report->LocalValue = Slot->Value[0];
+    Report->LocalLost  = false;
+
+    Voter->AgreeMask = 0;
+    for (i = 0; i < Input.Count; i++)
+    {
+        Voter->AgreeMask |= ((Mask >> i) & 1U) << Index[i];
+    }
+
+    ++Voter->Stats.EpochsVoted;
+    if ((Slot->Present & Complete) != Complete)
+    {
+        ++Voter->Stats.EpochsIncomplete;
+    }
+
+    if (Report->Outcome == TEC_CORE_VOTE_NO_MAJORITY)
+    {
+        return true;
+    }
+
+    Voter->VotedEpoch = Slot->Epoch;
+    Voter->VoteValid  = true;
+
+    for (i = 0; i < TEC_CORE_VOTER_MAX; i++)
+    {
+        if (Shadow & ((uint32_t)1 << i))
+        {
+            Distance = (Slot->Value[i] > Voter->Temperature) ? Slot->Value[i] - Voter->Temperature
+                                                             : Voter->Temperature - Slot->Value[i];
+            ShadowOk |= (uint32_t)(Distance <= Voter->Config.Tolerance) << i;
+        }
+    }
+
+    TEC_Core_HealthVote(&Voter->Health, Voters, Voter->AgreeMask, Shadow, ShadowOk);
+
+    if ((Voters & 1U) && !(Voter->AgreeMask & 1U))
+    {
+        ++Voter->LocalVotesLost;
+        Report->LocalLost = true;
+    }
+
+    return true;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Close the health window once it is due                          */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool TEC_Core_VoterHealthUpdate(TEC_Core_Voter_t *Voter, uint32_t Now, uint32_t *Masked, uint32_t *Reintegrated,
+                                uint32_t *Seen)
+{
+    *Seen = Voter->Health.Seen;
+
+    return TEC_Core_HealthUpdate(&Voter->Health, Now, Voter->Config.HealthWindow, Masked, Reintegrated);
+}
@@ -40,5 +40,23 @@
 #define TEC_TABLE_REG_ERR_EID   12
 #define TEC_TEMPERATURE_INF_EID 13
 #define TEC_INVALID_ERR_EID     14
+#define TEC_RESET_DIAG_INF_EID  15
+#define TEC_SELF_BENCH_INF_EID  16
+#define TEC_SELF_BENCH_ERR_EID  17
+#define TEC_HWCOUNT_INF_EID     18
+#define TEC_CAPTURE_INF_EID     19
+#define TEC_CAPTURE_ERR_EID     20
+#define TEC_SAMPLER_ERR_EID     21
+#define TEC_CONFIG_INF_EID      22
+#define TEC_REPLICA_INF_EID     23
+#define TEC_REPLICA_ERR_EID     24
+#define TEC_HEALTH_INF_EID      25
+#define TEC_UDP_INF_EID         26
+#define TEC_UDP_ERR_EID         27
+#define TEC_STATE_INF_EID       28
+#define TEC_CDS_INF_EID         29
+#define TEC_CDS_ERR_EID         30
+#define TEC_STARTUP_INF_EID     31
+#define TEC_HWCOUNT_ERR_EID     32
 
 #endif /* TEC_EVENTS_H */
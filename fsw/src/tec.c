@@ -21,8 +21,6 @@
  *   This file contains the source code for the TEC App.
  */
 
-#include <stdlib.h>
-
 /*
 ** Include Files:
 */
@@ -31,10 +29,41 @@
 #include "tec_utils.h"
 #include "tec_eventids.h"
 #include "tec_dispatch.h"
+#include "tec_diag.h"
+#include "tec_selfbench.h"
+#include "tec_hwcount.h"
+#include "tec_capture.h"
+#include "tec_voter.h"
+#include "tec_sampler.h"
+#include "tec_state.h"
+#include "tec_pipes.h"
+#include "tec_replica.h"
+#include "tec_udp.h"
+#include "tec_cds.h"
 #include "tec_tbl.h"
 #include "tec_version.h"
 
+#include "tec_core.h"
+
+#include "cfe_psp.h"
+
+/*
+** Phases of TEC_Init timed for the startup event
+*/
+#define TEC_INIT_PHASE_EVS       0
+#define TEC_INIT_PHASE_PIPES     1
+#define TEC_INIT_PHASE_SUBSCRIBE 2
+#define TEC_INIT_PHASE_TABLES    3
+#define TEC_INIT_PHASE_CONFIG    4
+#define TEC_INIT_PHASE_CDS       5
+#define TEC_INIT_PHASE_SAMPLER   6
+#define TEC_INIT_PHASE_COUNT     7
+
 static CFE_Status_t TEC_ReadTemperature(void);
+static CFE_Status_t TEC_DrainPipe(uint8 Pipe, CFE_SB_Buffer_t *SBBufPtr, uint32 BatchMax);
+static void         TEC_DrainUdp(uint32 BatchMax);
+static void         TEC_ProcessMessage(uint8 Pipe, const CFE_SB_Buffer_t *SBBufPtr);
+static void         TEC_PeriodicWork(void);
 
 /*
 ** global data
@@ -51,6 +80,11 @@ void TEC_Main(void)
     CFE_Status_t     status;
     CFE_SB_Buffer_t *SBBufPtr;
 
+    /*
+    ** Create the first Performance Log entry
+    */
+    TEC_PERF_ENTRY(TEC_PERF_ID);
+
     /*
     ** Perform application-specific initialization
     ** If the Initialization fails, set the RunStatus to
@@ -73,22 +107,51 @@ void TEC_Main(void)
     */
     while (CFE_ES_RunLoop(&TEC_Data.RunStatus) == true)
     {
+        /*
+        ** Performance Log Exit Stamp
+        */
+        TEC_PERF_EXIT(TEC_PERF_ID);
 
-        /* Pend on receipt of command packet */
-        status = CFE_SB_ReceiveBuffer(&SBBufPtr, TEC_Data.CommandPipe, CFE_SB_PEND_FOREVER);
+        /*
+        ** Pend on the command pipe, at most until periodic work is due. The
+        ** scheduler wakeup arrives there too, so replica telemetry waits at
+        ** most one wakeup period.
+        */
+        status = CFE_SB_ReceiveBuffer(&SBBufPtr, TEC_Data.CommandPipe, TEC_RX_TIMEOUT_MSEC);
+
+        /*
+        ** Performance Log Entry Stamp
+        */
+        TEC_PERF_ENTRY(TEC_PERF_ID);
 
+        /*
+        ** Service the pipes in priority order, commands first; the periodic
+        ** work below then votes once on the newest values
+        */
         if (status == CFE_SUCCESS)
         {
-            TEC_Data.HkTlm.Payload.reserved = TEC_Data.HkTlm.Payload.reserved + 1;
+            status = TEC_DrainPipe(TEC_PIPE_CMD, SBBufPtr, TEC_RX_BATCH_MAX);
+        }
+        else if (status == CFE_SB_TIME_OUT)
+        {
+            /* No command or wakeup, but time has still passed */
+            ++TEC_Data.DiagTlm.Payload.ReceiveTimeouts;
+            status = CFE_SB_NO_MESSAGE;
+        }
 
-            status = TEC_ReadTemperature();
-            if (status != CFE_SUCCESS)
-            {
-                CFE_EVS_SendEvent(TEC_VALUE_INF_EID, CFE_EVS_EventType_ERROR,
-                                "TEC App: TEC_ReadTemperature , RC = 0x%08lX", (unsigned long)status);
-            }
+        if (status == CFE_SUCCESS || status == CFE_SB_NO_MESSAGE)
+        {
+            status = TEC_DrainPipe(TEC_PIPE_REPLICA, NULL, TEC_REPLICA_BATCH_MAX);
+        }
 
-            TEC_TaskPipe(SBBufPtr);
+        if (status == CFE_SUCCESS || status == CFE_SB_NO_MESSAGE)
+        {
+            TEC_DrainUdp(TEC_REPLICA_BATCH_MAX);
+        }
+
+        if (status == CFE_SUCCESS || status == CFE_SB_NO_MESSAGE)
+        {
+            TEC_PeriodicWork();
         }
         else
         {
@@ -99,9 +162,145 @@ void TEC_Main(void)
         }
     }
 
+    /*
+    ** Performance Log Exit Stamp
+    */
+    TEC_PERF_EXIT(TEC_PERF_ID);
+
+    TEC_CaptureStop();
+    TEC_UdpClose();
+    TEC_CdsSave();
+
     CFE_ES_ExitApp(TEC_Data.RunStatus);
 }
 
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *  */
+/*                                                                            */
+/* Handle the given message, if any, and whatever is queued behind it on the  */
+/* pipe, up to BatchMax messages                                              */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static CFE_Status_t TEC_DrainPipe(uint8 Pipe, CFE_SB_Buffer_t *SBBufPtr, uint32 BatchMax)
+{
+    CFE_Status_t status = CFE_SUCCESS;
+    uint32       BatchCount;
+
+    for (BatchCount = 0; BatchCount < BatchMax; ++BatchCount)
+    {
+        if (SBBufPtr == NULL)
+        {
+            status = CFE_SB_ReceiveBuffer(&SBBufPtr, TEC_PipeId(Pipe), CFE_SB_POLL);
+            if (status != CFE_SUCCESS)
+            {
+                break;
+            }
+        }
+
+        TEC_ProcessMessage(Pipe, SBBufPtr);
+        SBBufPtr = NULL;
+    }
+
+    return status;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *  */
+/*                                                                            */
+/* Handle up to BatchMax packets received over UDP. Only packets of a        */
+/* configured replica are taken, straight to the replica handler, which      */
+/* checks their length; the rest never reach the dispatcher and are only     */
+/* counted                                                                    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void TEC_DrainUdp(uint32 BatchMax)
+{
+    CFE_SB_Buffer_t *SBBufPtr;
+    CFE_SB_MsgId_t   MsgId = CFE_SB_INVALID_MSG_ID;
+    uint8            ReplicaIndex;
+    uint32           BatchCount;
+    OS_time_t        HandlerStart;
+
+    for (BatchCount = 0; BatchCount < BatchMax && TEC_UdpReceive(&SBBufPtr); ++BatchCount)
+    {
+        CFE_MSG_GetMsgId(&SBBufPtr->Msg, &MsgId);
+
+        if (!TEC_ReplicaLookup(MsgId, &ReplicaIndex))
+        {
+            ++TEC_Data.DiagTlm.Payload.UdpRejected;
+            continue;
+        }
+
+        TEC_DiagMarkReceive();
+        TEC_PipesAccount(TEC_PIPE_REPLICA, SBBufPtr);
+        TEC_CaptureRecord(SBBufPtr);
+
+        CFE_PSP_GetTime(&HandlerStart);
+        TEC_ReplicaReceive(ReplicaIndex, SBBufPtr);
+        TEC_DiagRecord(TEC_DIAG_PATH_REPLICA, HandlerStart);
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *  */
+/*                                                                            */
+/* Handle one received message                                                */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void TEC_ProcessMessage(uint8 Pipe, const CFE_SB_Buffer_t *SBBufPtr)
+{
+    TEC_DiagMarkReceive();
+    TEC_PipesAccount(Pipe, SBBufPtr);
+    TEC_CaptureRecord(SBBufPtr);
+
+    TEC_Data.HkTlm.Payload.reserved = TEC_Data.HkTlm.Payload.reserved + 1;
+
+    TEC_PERF_ENTRY(TEC_TASK_PIPE_PERF_ID);
+    TEC_HwCountBegin(TEC_HWCOUNT_STAGE_TASK_PIPE);
+    TEC_TaskPipe(SBBufPtr);
+    TEC_HwCountEnd(TEC_HWCOUNT_STAGE_TASK_PIPE);
+    TEC_PERF_EXIT(TEC_TASK_PIPE_PERF_ID);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *  */
+/*                                                                            */
+/* Work due on every pass of the main loop, whether or not anything arrived   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void TEC_PeriodicWork(void)
+{
+    CFE_Status_t ReadStatus;
+
+    ReadStatus = TEC_ReadTemperature();
+    if (ReadStatus != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(TEC_VALUE_INF_EID, CFE_EVS_EventType_ERROR,
+                          "TEC App: TEC_ReadTemperature , RC = 0x%08lX", (unsigned long)ReadStatus);
+    }
+
+    TEC_Core_VoterLocalHealthy(&TEC_Data.Voter, ReadStatus == CFE_SUCCESS);
+
+    /* Vote on every sample epoch that is complete or past its deadline */
+    TEC_MajorityVoter();
+
+    /* Keep the vote state for a restart */
+    TEC_CdsSave();
+
+    /* Advance a pending self-benchmark by one slice */
+    TEC_SelfBenchRunSlice();
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *  */
+/*                                                                            */
+/* Record the duration of an initialization phase and start the next one      */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void TEC_InitPhaseDone(uint32 *PhaseUsec, OS_time_t *PhaseStart)
+{
+    OS_time_t Now;
+
+    CFE_PSP_GetTime(&Now);
+    *PhaseUsec  = (uint32)OS_TimeGetTotalMicroseconds(OS_TimeSubtract(Now, *PhaseStart));
+    *PhaseStart = Now;
+}
+
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *  */
 /*                                                                            */
 /* Initialization                                                             */
@@ -111,10 +310,16 @@ CFE_Status_t TEC_Init(void)
 {
     CFE_Status_t status;
     char         VersionString[TEC_CFG_MAX_VERSION_STR_LEN];
+    uint32       PhaseUsec[TEC_INIT_PHASE_COUNT] = {0};
+    OS_time_t    PhaseStart;
+    OS_time_t    Now;
 
     /* Zero out the global data structure */
     memset(&TEC_Data, 0, sizeof(TEC_Data));
 
+    /* Restart to first vote is measured from here, see TEC_VoteEpoch */
+    CFE_PSP_GetTime(&TEC_Data.InitStart);
+
     TEC_Data.RunStatus = CFE_ES_RunStatus_APP_RUN;
 
     /*
@@ -122,7 +327,13 @@ CFE_Status_t TEC_Init(void)
     */
     TEC_Data.PipeDepth = TEC_PIPE_DEPTH;
 
-    TEC_Data.TemperatureUnitHk = 'C';
+    TEC_Core_VoterInit(&TEC_Data.Voter);
+
+    TEC_CaptureInit();
+    TEC_UdpInit();
+
+    /* Created with the sampling task, see TEC_SamplerConfigure */
+    TEC_Data.SampleMutexId = OS_OBJECT_ID_UNDEFINED;
 
     // TEC_Data.ProcessorID = CFE_PSP_GetProcessorId();
 
@@ -132,7 +343,9 @@ CFE_Status_t TEC_Init(void)
     /*
     ** Register the events
     */
+    CFE_PSP_GetTime(&PhaseStart);
     status = CFE_EVS_Register(NULL, 0, CFE_EVS_EventFilter_BINARY);
+    TEC_InitPhaseDone(&PhaseUsec[TEC_INIT_PHASE_EVS], &PhaseStart);
     if (status != CFE_SUCCESS)
     {
         CFE_ES_WriteToSysLog("TEC App: Error Registering Events, RC = 0x%08lX\n", (unsigned long)status);
@@ -145,6 +358,16 @@ CFE_Status_t TEC_Init(void)
         CFE_MSG_Init(CFE_MSG_PTR(TEC_Data.HkTlm.TelemetryHeader), CFE_SB_ValueToMsgId(TEC_HK_TLM_MID),
                      sizeof(TEC_Data.HkTlm));
 
+        /*
+         ** Initialize diagnostics packet (clear latency histograms).
+         */
+        TEC_DiagInit();
+
+        /*
+         ** Initialize self-benchmark result packet.
+         */
+        TEC_SelfBenchInit();
+
         /*
          ** Create Software Bus message pipe.
          */
@@ -159,73 +382,113 @@ CFE_Status_t TEC_Init(void)
     if (status == CFE_SUCCESS)
     {
         /*
-        ** Subscribe to Housekeeping request commands
+        ** Create the replica pipe
         */
-        CFE_EVS_SendDbg(TEC_INIT_INF_EID, "Subscribing to 0x%04x", TEC_SEND_HK_MID);
-        status = CFE_SB_Subscribe(CFE_SB_ValueToMsgId(TEC_SEND_HK_MID), TEC_Data.CommandPipe);
-        if (status != CFE_SUCCESS)
-        {
-            CFE_EVS_SendEvent(TEC_SUB_HK_ERR_EID, CFE_EVS_EventType_ERROR,
-                              "TEC App: Error Subscribing to HK request, RC = 0x%08lX", (unsigned long)status);
-        }
+        status = TEC_PipesInit();
+        TEC_InitPhaseDone(&PhaseUsec[TEC_INIT_PHASE_PIPES], &PhaseStart);
     }
 
     if (status == CFE_SUCCESS)
     {
         /*
-        ** Subscribe to ground command packets
+        ** Subscribe to HK requests, scheduler wakeups, ground commands and
+        ** state transfer; the replicas listed in the configuration table
+        ** are subscribed when it is loaded
         */
-        CFE_EVS_SendDbg(TEC_INIT_INF_EID, "Subscribing to 0x%04x", TEC_CMD_MID);
-        status = CFE_SB_Subscribe(CFE_SB_ValueToMsgId(TEC_CMD_MID), TEC_Data.CommandPipe);
-        if (status != CFE_SUCCESS)
-        {
-            CFE_EVS_SendEvent(TEC_SUB_CMD_ERR_EID, CFE_EVS_EventType_ERROR,
-                              "TEC App: Error Subscribing to Commands, RC = 0x%08lX", (unsigned long)status);
-        }
+        status = TEC_PipesSubscribe();
+        TEC_InitPhaseDone(&PhaseUsec[TEC_INIT_PHASE_SUBSCRIBE], &PhaseStart);
     }
 
     if (status == CFE_SUCCESS)
     {
         /*
-        ** Subscribe to other processors telemetry (CPU_A, CPU_B)
+        ** Register Example Table(s)
         */
-        CFE_EVS_SendDbg(TEC_INIT_INF_EID, "Subscribing to 0x%04x", TEC_CMD_MID);
-        status = CFE_SB_Subscribe(CFE_SB_ValueToMsgId(CPUA_HK_MID), TEC_Data.CommandPipe);
+        status = CFE_TBL_Register(&TEC_Data.TblHandles[TEC_EXAMPLE_TBL_IDX], "ExampleTable",
+                                  sizeof(TEC_ExampleTable_t), CFE_TBL_OPT_DEFAULT, TEC_TblValidationFunc);
         if (status != CFE_SUCCESS)
         {
-            CFE_EVS_SendEvent(TEC_SUB_CMD_ERR_EID, CFE_EVS_EventType_ERROR,
-                              "TEC App: Error Subscribing to Commands, RC = 0x%08lX", (unsigned long)status);
+            CFE_EVS_SendEvent(TEC_TABLE_REG_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "TEC App: Error Registering Example Table, RC = 0x%08lX", (unsigned long)status);
         }
-        status = CFE_SB_Subscribe(CFE_SB_ValueToMsgId(CPUB_HK_MID), TEC_Data.CommandPipe);
-        if (status != CFE_SUCCESS)
+        else
         {
-            CFE_EVS_SendEvent(TEC_SUB_CMD_ERR_EID, CFE_EVS_EventType_ERROR,
-                              "TEC App: Error Subscribing to Commands, RC = 0x%08lX", (unsigned long)status);
+            status = CFE_TBL_Load(TEC_Data.TblHandles[TEC_EXAMPLE_TBL_IDX], CFE_TBL_SRC_FILE, TEC_TABLE_FILE);
         }
     }
 
     if (status == CFE_SUCCESS)
     {
         /*
-        ** Register Example Table(s)
+        ** Register and load the Configuration Table
         */
-        status = CFE_TBL_Register(&TEC_Data.TblHandles[0], "ExampleTable", sizeof(TEC_ExampleTable_t),
-                                  CFE_TBL_OPT_DEFAULT, TEC_TblValidationFunc);
+        status = CFE_TBL_Register(&TEC_Data.TblHandles[TEC_CONFIG_TBL_IDX], "ConfigTable", sizeof(TEC_ConfigTable_t),
+                                  CFE_TBL_OPT_DEFAULT, TEC_ConfigTblValidationFunc);
         if (status != CFE_SUCCESS)
         {
             CFE_EVS_SendEvent(TEC_TABLE_REG_ERR_EID, CFE_EVS_EventType_ERROR,
-                              "TEC App: Error Registering Example Table, RC = 0x%08lX", (unsigned long)status);
+                              "TEC App: Error Registering Config Table, RC = 0x%08lX", (unsigned long)status);
         }
         else
         {
-            status = CFE_TBL_Load(TEC_Data.TblHandles[0], CFE_TBL_SRC_FILE, TEC_TABLE_FILE);
+            status = CFE_TBL_Load(TEC_Data.TblHandles[TEC_CONFIG_TBL_IDX], CFE_TBL_SRC_FILE, TEC_CONFIG_TABLE_FILE);
         }
+        TEC_InitPhaseDone(&PhaseUsec[TEC_INIT_PHASE_TABLES], &PhaseStart);
+    }
+
+    if (status == CFE_SUCCESS)
+    {
+        /*
+        ** Apply the configuration table: replica membership, transport, voting
+        */
+        status = TEC_LoadConfigTable();
+        TEC_InitPhaseDone(&PhaseUsec[TEC_INIT_PHASE_CONFIG], &PhaseStart);
+    }
+
+    if (status == CFE_SUCCESS)
+    {
+        /*
+        ** Resume from the vote state kept in the CDS over a processor or
+        ** app reset; it needs the replica membership from the table
+        */
+        TEC_CdsInit();
+        TEC_InitPhaseDone(&PhaseUsec[TEC_INIT_PHASE_CDS], &PhaseStart);
 
+        /*
+        ** Start sampling the sensor from the child task
+        */
+        status = TEC_SamplerInit();
+        TEC_InitPhaseDone(&PhaseUsec[TEC_INIT_PHASE_SAMPLER], &PhaseStart);
+    }
+
+    if (status == CFE_SUCCESS)
+    {
         CFE_Config_GetVersionString(VersionString, TEC_CFG_MAX_VERSION_STR_LEN, "TEC App", TEC_VERSION,
                                     TEC_BUILD_CODENAME, TEC_LAST_OFFICIAL);
 
+        /*
+        ** Open the hardware performance counters, if configured and available
+        */
+        TEC_HwCountInit();
+
+        /*
+        ** Ask the other replicas for the vote state, so a restarted node
+        ** joins the vote without waiting through vote cycles of its own
+        */
+        TEC_StateRequest();
+
         CFE_EVS_SendEvent(TEC_INIT_INF_EID, CFE_EVS_EventType_INFORMATION, "TEC App Initialized.%s",
                           VersionString);
+
+        CFE_PSP_GetTime(&Now);
+        CFE_EVS_SendEvent(TEC_STARTUP_INF_EID, CFE_EVS_EventType_INFORMATION,
+                          "TEC App: Startup %lu us (evs %lu pipe %lu sub %lu tbl %lu cfg %lu cds %lu task %lu)",
+                          (unsigned long)OS_TimeGetTotalMicroseconds(OS_TimeSubtract(Now, TEC_Data.InitStart)),
+                          (unsigned long)PhaseUsec[TEC_INIT_PHASE_EVS], (unsigned long)PhaseUsec[TEC_INIT_PHASE_PIPES],
+                          (unsigned long)PhaseUsec[TEC_INIT_PHASE_SUBSCRIBE],
+                          (unsigned long)PhaseUsec[TEC_INIT_PHASE_TABLES],
+                          (unsigned long)PhaseUsec[TEC_INIT_PHASE_CONFIG], (unsigned long)PhaseUsec[TEC_INIT_PHASE_CDS],
+                          (unsigned long)PhaseUsec[TEC_INIT_PHASE_SAMPLER]);
     }
 
     return status;
@@ -233,37 +496,30 @@ CFE_Status_t TEC_Init(void)
 
 void TEC_ConvertHkTemperature(char Unit)
 {
-    TEC_Data.TemperatureUnitHk = Unit;
+    TEC_VoterSetUnit(Unit);
 }
 
 static CFE_Status_t TEC_ReadTemperature(void)
 {
     CFE_Status_t status = CFE_SUCCESS;
 
-    /* "Read" the temperature, gives a value between 0 and 255 */
-    // uint32 Temp = rand() % 256;
-    uint32 Temp = 55;
+    TEC_PERF_ENTRY(TEC_READ_TEMP_PERF_ID);
 
-    if(TEC_Data.TemperatureUnitHk == 'C')
-    {
-        TEC_Data.TemperatureHk = Temp;
-    }
-    else if (TEC_Data.TemperatureUnitHk == 'F')
+    /* Take the newest sample from the sampling task, gives a value between 0 and 255 */
+    TEC_SamplerDrain();
+
+    if (!TEC_Core_ConvertTemperature(TEC_Data.SampleRaw, TEC_Data.Voter.Unit, &TEC_Data.TemperatureHk))
     {
-        // Note: could to a sanity check for the value to be in range
-        TEC_Data.TemperatureHk = Temp * 2 + 32;
-    }
-    else
-    {   
-        TEC_Data.TemperatureUnitHk = 'C';
-        TEC_Data.TemperatureHk = Temp;
+        TEC_VoterSetUnit('C');
         CFE_EVS_SendEvent(TEC_INVALID_ERR_EID, CFE_EVS_EventType_ERROR,
                             "TEC: Invalid unit specifier %c. Please use C or F. Defaulting to C.\n", 
-                            TEC_Data.TemperatureUnitHk);
+                            TEC_Data.Voter.Unit);
 
         status = CFE_STATUS_RANGE_ERROR;
     }
 
+    TEC_PERF_EXIT(TEC_READ_TEMP_PERF_ID);
+
     return status;
 
 }
\ No newline at end of file
@@ -37,6 +37,26 @@
 #include "tec_perfids.h"
 #include "tec_msgids.h"
 #include "tec_msg.h"
+#include "tec_tbl.h"
+
+#include "tec_core.h"
+#include "tec_core_ring.h"
+#include "tec_core_voter.h"
+
+/************************************************************************
+** Macro Definitions
+*************************************************************************/
+
+/*
+** Performance log markers, see tec_perfids.h for the stage IDs
+*/
+#if TEC_PERF_LOG_ENABLED
+#define TEC_PERF_ENTRY(id) CFE_ES_PerfLogEntry(id)
+#define TEC_PERF_EXIT(id)  CFE_ES_PerfLogExit(id)
+#else
+#define TEC_PERF_ENTRY(id) ((void)0)
+#define TEC_PERF_EXIT(id)  ((void)0)
+#endif
 
 /************************************************************************
 ** Type Definitions
@@ -44,6 +64,41 @@
 
 // #define LocalProcessorID    CFE_PLATFORM_TBL_VALID_PRID_1
 
+/*
+** Vote state kept in the Critical Data Store across processor and app
+** resets, see tec_cds.c. Voter health is only restored if the replica
+** membership it belongs to is still the configured one.
+*/
+typedef struct
+{
+    uint32              Temperature;
+    uint32              VotedEpoch;
+    uint32              VoteAgreeMask;
+    uint32              LocalVotesLost;
+    uint32              VoterActive;
+    uint32              VoterProbation;
+    uint32              SamplePeriodMsec; /* Epochs are only comparable under the same period */
+    uint32              ReplicaCount;
+    CFE_SB_MsgId_Atom_t ReplicaMsgId[TEC_MAX_REPLICAS];
+    uint8               CmdCounter;
+    uint8               ErrCounter;
+    char                TemperatureUnitHk;
+    bool                VoteValid;
+} TEC_CdsData_t;
+
+/*
+** Configuration the sampling child task runs on. The main task publishes
+** it under SampleMutexId whenever the configuration table is loaded, and
+** the child copies it once per sample, so it never sees a partial load.
+*/
+typedef struct
+{
+    uint32              PeriodMsec;
+    uint32              PhaseMsec;
+    uint32              Mode;
+    CFE_SB_MsgId_Atom_t ExchangeMsgId;
+} TEC_SamplerConfig_t;
+
 /*
 ** Global Data
 */
@@ -59,19 +114,90 @@ typedef struct
     ** Sensor inputs...
     */
     
-    // This is the majority voted temperature
-    uint32 Temperature;
+    // The vote: replica membership, epochs, voter health and the voted temperature, in the unit of Voter.Unit
+    TEC_Core_Voter_t Voter;
+    // Asked the other replicas for the vote state on startup, no answer yet
+    bool StatePending;
     // This is the locally measure temperature
     uint32 TemperatureHk;
-    char TemperatureUnitHk;
-    // Those are the remotely measured temperatures
-    uint32 RemoteTemperatures[2];
+
+    /*
+    ** Sampling child task and the ring it fills...
+    */
+    CFE_ES_TaskId_t       SampleTaskId;
+    TEC_Core_SampleRing_t SampleRing;
+    uint32                SampleRaw;         /* Newest raw sample taken from the ring */
+    CFE_TIME_SysTime_t    SampleTime;        /* Time the newest sample was taken */
+    uint32                SampleOverrunBase; /* SampleRing.Overruns at the last diagnostics reset */
+    osal_id_t             SampleMutexId;     /* Guards SampleConfig and the UDP transmit state */
+    TEC_SamplerConfig_t   SampleConfig;      /* Published by the main task, see TEC_SamplerConfigure */
+
+    /*
+    ** Replica exchange packet, written only by the sampling task...
+    */
+    TEC_ExchangeTlm_t       ExchangeTlm;
+    uint32                  ExchangeOverruns; /* SampleRing.Overruns when the previous packet was sent */
+    CFE_MSG_SequenceCount_t ExchangeSeq;      /* Sequence count of the next packet */
+
+    /*
+    ** Direct UDP replica transport, see tec_udp.c; everything up to UdpTxCount
+    ** is shared with the sampling task under SampleMutexId...
+    */
+    osal_id_t         UdpSocketId;
+    bool              UdpActive; /* Exchange packets are sent over UDP rather than the software bus */
+    uint32            UdpPeerCount;
+    OS_SockAddr_t     UdpPeerAddr[TEC_MAX_REPLICAS];
+    uint32            UdpBatch;
+    TEC_ExchangeTlm_t UdpTx[TEC_UDP_BATCH_MAX]; /* Datagram being filled by the sampling task */
+    uint32            UdpTxCount;
+    TEC_ExchangeTlm_t UdpRx[TEC_UDP_BATCH_MAX]; /* Datagram being handed to the dispatcher */
+    uint32            UdpRxCount;
+    uint32            UdpRxNext;
+
+    /*
+    ** Active copy of the configuration table...
+    */
+    TEC_ConfigTable_t Config;
 
     /*
     ** Housekeeping telemetry packet...
     */
     TEC_HkTlm_t HkTlm;
 
+    /*
+    ** Diagnostics telemetry packet and the receive time of the message in work...
+    */
+    TEC_DiagTlm_t DiagTlm;
+    OS_time_t     ReceiveTime;
+
+    /*
+    ** Self-benchmark result packet and run state...
+    */
+    TEC_SelfBenchTlm_t SelfBenchTlm;
+    uint32             SelfBenchRemaining;
+    uint64             SelfBenchConvertNsec;
+    uint64             SelfBenchVoteNsec;
+
+    /*
+    ** Software bus capture file...
+    */
+    osal_id_t CaptureFileId;
+    uint32    CaptureRecords;
+
+    /*
+    ** Critical Data Store block and the copy last written to it...
+    */
+    CFE_ES_CDSHandle_t CdsHandle;
+    bool               CdsActive;
+    TEC_CdsData_t      CdsData;
+
+    /*
+    ** Start of TEC_Init, and the time from there to the first vote...
+    */
+    OS_time_t InitStart;
+    bool      FirstVoted;
+    uint32    FirstVoteMsec;
+
     /*
     ** Run Status variable used in the main processing loop
     */
@@ -81,6 +207,13 @@ typedef struct
     ** Operational data (not reported in housekeeping)...
     */
     CFE_SB_PipeId_t CommandPipe;
+    CFE_SB_PipeId_t ReplicaPipe;
+
+    /*
+    ** Last sequence count seen per subscription, see tec_pipes.c...
+    */
+    uint16 SubSeq[TEC_MAX_SUBSCRIPTIONS];
+    bool   SubSeqValid[TEC_MAX_SUBSCRIPTIONS];
 
     /*
     ** Initialization data (not reported in housekeeping)...
@@ -0,0 +1,242 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the TEC App software bus capture.
+ *
+ * While a capture is open every buffer handed to TEC_TaskPipe is appended to
+ * the capture file with its receive time and size, together with the vote
+ * inputs that do not arrive as messages and the vote state whenever it is
+ * changed from outside the vote path, see tec_capture_fmt.h.
+ * bench/tec_replay.c plays such a file back on a host.
+ */
+
+/*
+** Include Files:
+*/
+#include "tec.h"
+#include "tec_capture.h"
+#include "tec_eventids.h"
+
+#include "cfe_psp.h"
+
+#include "tec_capture_fmt.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Initialize capture state                                        */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_CaptureInit(void)
+{
+    TEC_Data.CaptureFileId  = OS_OBJECT_ID_UNDEFINED;
+    TEC_Data.CaptureRecords = 0;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Create the capture file and write its header                    */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+CFE_Status_t TEC_CaptureStart(const char *Filename)
+{
+    TEC_CaptureFileHdr_t FileHdr;
+    int32                OsStatus;
+
+    if (OS_ObjectIdDefined(TEC_Data.CaptureFileId))
+    {
+        return CFE_STATUS_INCORRECT_STATE;
+    }
+
+    OsStatus = OS_OpenCreate(&TEC_Data.CaptureFileId, Filename, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE,
+                             OS_WRITE_ONLY);
+    if (OsStatus != OS_SUCCESS)
+    {
+        TEC_Data.CaptureFileId = OS_OBJECT_ID_UNDEFINED;
+        CFE_EVS_SendEvent(TEC_CAPTURE_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "TEC: Error creating capture file %s, RC = %ld", Filename, (long)OsStatus);
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    FileHdr.Magic   = TEC_Core_CaptureLE32(TEC_CAPTURE_MAGIC);
+    FileHdr.Version = TEC_Core_CaptureLE32(TEC_CAPTURE_VERSION);
+    FileHdr.Flags   = TEC_Core_CaptureLE32(TEC_Core_CaptureFlags());
+
+    FileHdr.CmdMsgId      = TEC_Core_CaptureLE32(TEC_CMD_MID);
+    FileHdr.SendHkMsgId   = TEC_Core_CaptureLE32(TEC_SEND_HK_MID);
+    FileHdr.WakeupMsgId   = TEC_Core_CaptureLE32(TEC_WAKEUP_MID);
+    FileHdr.StateReqMsgId = TEC_Core_CaptureLE32(TEC_STATE_REQ_MID);
+    FileHdr.StateRspMsgId = TEC_Core_CaptureLE32(TEC_STATE_RSP_MID);
+
+    OsStatus = OS_write(TEC_Data.CaptureFileId, &FileHdr, sizeof(FileHdr));
+    if (OsStatus != (int32)sizeof(FileHdr))
+    {
+        OS_close(TEC_Data.CaptureFileId);
+        TEC_Data.CaptureFileId = OS_OBJECT_ID_UNDEFINED;
+        CFE_EVS_SendEvent(TEC_CAPTURE_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "TEC: Error writing capture file %s, RC = %ld", Filename, (long)OsStatus);
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    TEC_Data.CaptureRecords = 0;
+
+    /* The replay starts from the vote state as it is now */
+    TEC_CaptureVoter();
+
+    CFE_EVS_SendEvent(TEC_CAPTURE_INF_EID, CFE_EVS_EventType_INFORMATION, "TEC: Capturing to %s", Filename);
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Close the capture file                                          */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_CaptureStop(void)
+{
+    if (!OS_ObjectIdDefined(TEC_Data.CaptureFileId))
+    {
+        return;
+    }
+
+    OS_close(TEC_Data.CaptureFileId);
+    TEC_Data.CaptureFileId = OS_OBJECT_ID_UNDEFINED;
+
+    CFE_EVS_SendEvent(TEC_CAPTURE_INF_EID, CFE_EVS_EventType_INFORMATION, "TEC: Capture closed, %lu messages",
+                      (unsigned long)TEC_Data.CaptureRecords);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Append one record, stopping the capture if the write fails      */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void TEC_CaptureWrite(uint32 Type, OS_time_t Time, const void *Data, uint32 Size)
+{
+    TEC_CaptureRecordHdr_t RecordHdr;
+    int32                  OsStatus;
+
+    RecordHdr.Seconds     = TEC_Core_CaptureLE32((uint32)OS_TimeGetTotalSeconds(Time));
+    RecordHdr.Nanoseconds = TEC_Core_CaptureLE32(OS_TimeGetNanosecondsPart(Time));
+    RecordHdr.Size        = TEC_Core_CaptureLE32(Size);
+    RecordHdr.Type        = TEC_Core_CaptureLE32(Type);
+
+    OsStatus = OS_write(TEC_Data.CaptureFileId, &RecordHdr, sizeof(RecordHdr));
+    if (OsStatus == (int32)sizeof(RecordHdr))
+    {
+        OsStatus = OS_write(TEC_Data.CaptureFileId, Data, Size);
+        if (OsStatus == (int32)Size)
+        {
+            ++TEC_Data.CaptureRecords;
+            return;
+        }
+    }
+
+    CFE_EVS_SendEvent(TEC_CAPTURE_ERR_EID, CFE_EVS_EventType_ERROR,
+                      "TEC: Error writing capture record, RC = %ld, capture stopped", (long)OsStatus);
+    TEC_CaptureStop();
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Append one received buffer to the capture file                  */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_CaptureRecord(const CFE_SB_Buffer_t *SBBufPtr)
+{
+    CFE_MSG_Size_t Size = 0;
+
+    if (!OS_ObjectIdDefined(TEC_Data.CaptureFileId))
+    {
+        return;
+    }
+
+    CFE_MSG_GetSize(&SBBufPtr->Msg, &Size);
+
+    TEC_CaptureWrite(TEC_CAPTURE_RECORD_MSG, TEC_Data.ReceiveTime, SBBufPtr, (uint32)Size);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Append the whole vote state                                     */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_CaptureVoter(void)
+{
+    TEC_CaptureVoter_t Record;
+    OS_time_t          Now;
+
+    if (!OS_ObjectIdDefined(TEC_Data.CaptureFileId))
+    {
+        return;
+    }
+
+    CFE_PSP_GetTime(&Now);
+
+    TEC_Core_CaptureVoterSave(&TEC_Data.Voter, &Record);
+
+    TEC_CaptureWrite(TEC_CAPTURE_RECORD_VOTER, Now, &Record, sizeof(Record));
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Append a local sample filed for the vote                        */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_CaptureSample(uint32 Epoch, uint32 Raw)
+{
+    TEC_CaptureSample_t Sample;
+    OS_time_t           Now;
+
+    if (!OS_ObjectIdDefined(TEC_Data.CaptureFileId))
+    {
+        return;
+    }
+
+    CFE_PSP_GetTime(&Now);
+
+    Sample.Epoch = TEC_Core_CaptureLE32(Epoch);
+    Sample.Raw   = TEC_Core_CaptureLE32(Raw);
+
+    TEC_CaptureWrite(TEC_CAPTURE_RECORD_SAMPLE, Now, &Sample, sizeof(Sample));
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Append a pass of the voter                                      */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_CaptureTick(uint32 NowEpoch)
+{
+    TEC_CaptureTick_t Tick;
+    OS_time_t         Now;
+
+    if (!OS_ObjectIdDefined(TEC_Data.CaptureFileId))
+    {
+        return;
+    }
+
+    CFE_PSP_GetTime(&Now);
+
+    Tick.Now          = TEC_Core_CaptureLE32(NowEpoch);
+    Tick.LocalHealthy = TEC_Core_CaptureLE32(TEC_Data.Voter.HealthyMask & 1U);
+
+    TEC_CaptureWrite(TEC_CAPTURE_RECORD_TICK, Now, &Tick, sizeof(Tick));
+}
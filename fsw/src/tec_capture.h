@@ -0,0 +1,40 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *   This file contains the prototypes for the TEC App software bus capture
+ */
+
+#ifndef TEC_CAPTURE_H
+#define TEC_CAPTURE_H
+
+/*
+** Required header files.
+*/
+#include "tec.h"
+
+void         TEC_CaptureInit(void);
+CFE_Status_t TEC_CaptureStart(const char *Filename);
+void         TEC_CaptureStop(void);
+void         TEC_CaptureRecord(const CFE_SB_Buffer_t *SBBufPtr);
+void         TEC_CaptureVoter(void);
+void         TEC_CaptureSample(uint32 Epoch, uint32 Raw);
+void         TEC_CaptureTick(uint32 NowEpoch);
+
+#endif /* TEC_CAPTURE_H */
@@ -0,0 +1,209 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the TEC App Critical Data Store functions
+ *
+ *   The voted value, its epoch, the command counters and the voter states
+ *   are copied to a CDS block whenever they change. After a processor or
+ *   app reset cFE hands the block back, and TEC_Init resumes from it
+ *   instead of from zero; a power-on reset clears the CDS and the app
+ *   starts afresh. A vote older than the vote deadline is not resumed.
+ *   A replica's answer to the state request, see tec_state.c, may still
+ *   bring a newer vote.
+ */
+
+/*
+** Include Files:
+*/
+#include "tec.h"
+#include "tec_cds.h"
+#include "tec_eventids.h"
+#include "tec_voter.h"
+
+#include "tec_core_epoch.h"
+#include "tec_core_health.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Gather the state kept in the CDS                                */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void TEC_CdsCollect(TEC_CdsData_t *Data)
+{
+    uint32 i;
+
+    /* Cleared first, so unused entries and padding compare equal */
+    memset(Data, 0, sizeof(*Data));
+
+    Data->Temperature       = TEC_Data.Voter.Temperature;
+    Data->VotedEpoch        = TEC_Data.Voter.VotedEpoch;
+    Data->VoteAgreeMask     = TEC_Data.Voter.AgreeMask;
+    Data->LocalVotesLost    = TEC_Data.Voter.LocalVotesLost;
+    Data->VoterActive       = TEC_Data.Voter.Health.Active;
+    Data->VoterProbation    = TEC_Data.Voter.Health.Probation;
+    Data->SamplePeriodMsec  = TEC_Data.Config.SamplePeriodMsec;
+    Data->ReplicaCount      = TEC_Data.Voter.ReplicaCount;
+    Data->CmdCounter        = TEC_Data.CmdCounter;
+    Data->ErrCounter        = TEC_Data.ErrCounter;
+    Data->TemperatureUnitHk = TEC_Data.Voter.Unit;
+    Data->VoteValid         = TEC_Data.Voter.VoteValid;
+
+    for (i = 0; i < TEC_Data.Voter.ReplicaCount; i++)
+    {
+        Data->ReplicaMsgId[i] = TEC_Data.Voter.ReplicaId[i];
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Resume from the state restored from the CDS                     */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void TEC_CdsApply(const TEC_CdsData_t *Data)
+{
+    CFE_TIME_SysTime_t Now = CFE_TIME_GetTime();
+    bool               SameMembers;
+    uint32             NowEpoch;
+    uint32             i;
+
+    TEC_Data.CmdCounter           = Data->CmdCounter;
+    TEC_Data.ErrCounter           = Data->ErrCounter;
+    TEC_Data.Voter.LocalVotesLost = Data->LocalVotesLost;
+
+    if (Data->TemperatureUnitHk == 'C' || Data->TemperatureUnitHk == 'F')
+    {
+        TEC_VoterSetUnit(Data->TemperatureUnitHk);
+    }
+
+    /* Voter masks follow the replica order, which a table change may alter */
+    SameMembers = (Data->ReplicaCount == TEC_Data.Voter.ReplicaCount);
+    for (i = 0; SameMembers && i < TEC_Data.Voter.ReplicaCount; i++)
+    {
+        SameMembers = (Data->ReplicaMsgId[i] == TEC_Data.Voter.ReplicaId[i]);
+    }
+
+    if (SameMembers)
+    {
+        TEC_Core_HealthRestore(&TEC_Data.Voter.Health, TEC_Data.Voter.Health.Configured, Data->VoterActive,
+                               Data->VoterProbation);
+    }
+
+    /*
+    ** A vote older than the vote deadline says nothing about the replicas
+    ** now, and neither does one from the future of a clock that went back;
+    ** only the counters above carry over then
+    */
+    NowEpoch = TEC_Core_EpochOf(Now.Seconds, Now.Subseconds, TEC_Data.Config.SamplePeriodMsec);
+
+    if (Data->VoteValid && Data->SamplePeriodMsec == TEC_Data.Config.SamplePeriodMsec &&
+        NowEpoch - Data->VotedEpoch <= TEC_VOTE_DEADLINE_EPOCHS)
+    {
+        TEC_Core_EpochResume(&TEC_Data.Voter.Epochs, Data->VotedEpoch);
+
+        TEC_Data.Voter.Temperature = Data->Temperature;
+        TEC_Data.Voter.VotedEpoch  = Data->VotedEpoch;
+        TEC_Data.Voter.AgreeMask   = SameMembers ? Data->VoteAgreeMask : 0;
+        TEC_Data.Voter.VoteValid   = true;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Register the CDS block and restore the state it holds           */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_CdsInit(void)
+{
+    CFE_Status_t  status;
+    TEC_CdsData_t Restored;
+
+    TEC_Data.CdsActive = false;
+
+    status = CFE_ES_RegisterCDS(&TEC_Data.CdsHandle, sizeof(TEC_CdsData_t), TEC_CDS_NAME);
+    if (status == CFE_ES_CDS_ALREADY_EXISTS)
+    {
+        /* The CRC is checked by cFE; a damaged block is overwritten below */
+        status = CFE_ES_RestoreFromCDS(&Restored, TEC_Data.CdsHandle);
+        if (status == CFE_SUCCESS)
+        {
+            TEC_CdsApply(&Restored);
+
+            CFE_EVS_SendEvent(TEC_CDS_INF_EID, CFE_EVS_EventType_INFORMATION,
+                              "TEC App: Restored from CDS, vote %s at epoch %lu, active voters 0x%08lx",
+                              TEC_Data.Voter.VoteValid ? "valid" : "invalid", (unsigned long)TEC_Data.Voter.VotedEpoch,
+                              (unsigned long)TEC_Data.Voter.Health.Active);
+        }
+        else
+        {
+            CFE_EVS_SendEvent(TEC_CDS_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "TEC App: CDS contents invalid, starting afresh, RC = 0x%08lX",
+                              (unsigned long)status);
+        }
+
+        status = CFE_SUCCESS;
+    }
+
+    if (status != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(TEC_CDS_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "TEC App: Error registering CDS, state not kept across resets, RC = 0x%08lX",
+                          (unsigned long)status);
+        return;
+    }
+
+    TEC_Data.CdsActive = true;
+
+    TEC_CdsCollect(&TEC_Data.CdsData);
+    CFE_ES_CopyToCDS(TEC_Data.CdsHandle, &TEC_Data.CdsData);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Copy the state to the CDS if it changed since the last copy     */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_CdsSave(void)
+{
+    CFE_Status_t  status;
+    TEC_CdsData_t Current;
+
+    if (!TEC_Data.CdsActive)
+    {
+        return;
+    }
+
+    TEC_CdsCollect(&Current);
+    if (memcmp(&Current, &TEC_Data.CdsData, sizeof(Current)) == 0)
+    {
+        return;
+    }
+
+    status = CFE_ES_CopyToCDS(TEC_Data.CdsHandle, &Current);
+    if (status != CFE_SUCCESS)
+    {
+        TEC_Data.CdsActive = false;
+        CFE_EVS_SendEvent(TEC_CDS_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "TEC App: Error writing CDS, state no longer kept across resets, RC = 0x%08lX",
+                          (unsigned long)status);
+        return;
+    }
+
+    TEC_Data.CdsData = Current;
+}
@@ -31,6 +31,9 @@
 #include "tec_version.h"
 #include "tec_tbl.h"
 #include "tec_utils.h"
+#include "tec_diag.h"
+#include "tec_selfbench.h"
+#include "tec_capture.h"
 #include "tec_msg.h"
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
@@ -45,6 +48,8 @@ CFE_Status_t TEC_SendHkCmd(const TEC_SendHkCmd_t *Msg)
 {
     int i;
 
+    TEC_PERF_ENTRY(TEC_SEND_HK_PERF_ID);
+
     /*
     ** Get command execution counters...
     */
@@ -57,8 +62,14 @@ CFE_Status_t TEC_SendHkCmd(const TEC_SendHkCmd_t *Msg)
 
     // TEC_Data.HkTlm.Payload.reserved = 55;
 
-    TEC_Data.HkTlm.Payload.Unit = TEC_Data.TemperatureUnitHk;
+    TEC_Data.HkTlm.Payload.Unit = TEC_Data.Voter.Unit;
     TEC_Data.HkTlm.Payload.Temperature = TEC_Data.TemperatureHk;
+    TEC_Data.HkTlm.Payload.AgreeMask   = TEC_Data.Voter.AgreeMask;
+
+    TEC_Data.HkTlm.Payload.VoterActiveMask    = TEC_Data.Voter.Health.Active;
+    TEC_Data.HkTlm.Payload.VoterProbationMask = TEC_Data.Voter.Health.Probation;
+    TEC_Data.HkTlm.Payload.LocalVotesLost     = TEC_Data.Voter.LocalVotesLost;
+    TEC_Data.HkTlm.Payload.FirstVoteMsec      = TEC_Data.FirstVoteMsec;
 
     /*
     ** Send housekeeping telemetry packet...
@@ -66,13 +77,38 @@ CFE_Status_t TEC_SendHkCmd(const TEC_SendHkCmd_t *Msg)
     CFE_SB_TimeStampMsg(CFE_MSG_PTR(TEC_Data.HkTlm.TelemetryHeader));
     CFE_SB_TransmitMsg(CFE_MSG_PTR(TEC_Data.HkTlm.TelemetryHeader), true);
 
+    /*
+    ** Send diagnostics telemetry packet...
+    */
+    TEC_DiagSend();
+
+    TEC_PERF_EXIT(TEC_SEND_HK_PERF_ID);
+
     /*
     ** Manage any pending table loads, validations, etc.
     */
+    TEC_PERF_ENTRY(TEC_TBL_MANAGE_PERF_ID);
     for (i = 0; i < TEC_NUMBER_OF_TABLES; i++)
     {
-        CFE_TBL_Manage(TEC_Data.TblHandles[i]);
+        if (CFE_TBL_Manage(TEC_Data.TblHandles[i]) == CFE_TBL_INFO_UPDATED && i == TEC_CONFIG_TBL_IDX)
+        {
+            TEC_LoadConfigTable();
+        }
     }
+    TEC_PERF_EXIT(TEC_TBL_MANAGE_PERF_ID);
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Scheduler wakeup. The periodic work itself runs from the main     */
+/*         loop after every receive, so this only has to be counted          */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+CFE_Status_t TEC_WakeupCmd(const TEC_WakeupCmd_t *Msg)
+{
+    ++TEC_Data.DiagTlm.Payload.Wakeups;
 
     return CFE_SUCCESS;
 }
@@ -101,8 +137,9 @@ CFE_Status_t TEC_NoopCmd(const TEC_NoopCmd_t *Msg)
 /* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
 CFE_Status_t TEC_ResetCountersCmd(const TEC_ResetCountersCmd_t *Msg)
 {
-    TEC_Data.CmdCounter = 0;
-    TEC_Data.ErrCounter = 0;
+    TEC_Data.CmdCounter           = 0;
+    TEC_Data.ErrCounter           = 0;
+    TEC_Data.Voter.LocalVotesLost = 0;
 
     CFE_EVS_SendEvent(TEC_RESET_INF_EID, CFE_EVS_EventType_INFORMATION, "TEC: RESET command");
 
@@ -163,7 +200,7 @@ CFE_Status_t TEC_DisplayParamCmd(const TEC_DisplayParamCmd_t *Msg)
     return CFE_SUCCESS;
 }
 
-CFE_Status_t TEC_ConvertTemperatureCmd(const TEC_TemperatureHkCmd_t *Msg)
+CFE_Status_t TEC_ConvertTemperatureCmd(const TEC_GetTemperatureCmd_t *Msg)
 {
     TEC_Data.CmdCounter++;
 
@@ -174,3 +211,108 @@ CFE_Status_t TEC_ConvertTemperatureCmd(const TEC_TemperatureHkCmd_t *Msg)
 
     return CFE_SUCCESS;
 }
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         This function clears the latency histograms of the diagnostics     */
+/*         telemetry packet.                                                  */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+CFE_Status_t TEC_ResetDiagCmd(const TEC_ResetDiagCmd_t *Msg)
+{
+    TEC_Data.CmdCounter++;
+
+    TEC_DiagReset();
+
+    CFE_EVS_SendEvent(TEC_RESET_DIAG_INF_EID, CFE_EVS_EventType_INFORMATION, "TEC: RESET DIAG command");
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         This function arms the self-benchmark of the conversion and voting */
+/*         kernels. It runs in slices between messages, see                   */
+/*         TEC_SelfBenchRunSlice.                                             */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+CFE_Status_t TEC_SelfBenchCmd(const TEC_SelfBenchCmd_t *Msg)
+{
+    uint32 Iterations = Msg->Payload.Iterations;
+
+    if (Iterations == 0 || Iterations > TEC_SELF_BENCH_MAX_ITERATIONS)
+    {
+        TEC_Data.ErrCounter++;
+        CFE_EVS_SendEvent(TEC_SELF_BENCH_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "TEC: Self-benchmark iterations %lu out of range 1..%lu", (unsigned long)Iterations,
+                          (unsigned long)TEC_SELF_BENCH_MAX_ITERATIONS);
+        return CFE_STATUS_RANGE_ERROR;
+    }
+
+    if (TEC_Data.SelfBenchRemaining != 0)
+    {
+        TEC_Data.ErrCounter++;
+        CFE_EVS_SendEvent(TEC_SELF_BENCH_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "TEC: Self-benchmark already running, %lu iterations left",
+                          (unsigned long)TEC_Data.SelfBenchRemaining);
+        return CFE_STATUS_INCORRECT_STATE;
+    }
+
+    TEC_Data.CmdCounter++;
+
+    TEC_SelfBenchStart(Iterations);
+
+    CFE_EVS_SendEvent(TEC_SELF_BENCH_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "TEC: Self-benchmark started, %lu iterations", (unsigned long)Iterations);
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         This function starts capturing every received buffer to a file.   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+CFE_Status_t TEC_CaptureStartCmd(const TEC_CaptureStartCmd_t *Msg)
+{
+    CFE_Status_t status;
+    char         Filename[TEC_CAPTURE_FILENAME_LEN];
+
+    strncpy(Filename, Msg->Payload.Filename, sizeof(Filename) - 1);
+    Filename[sizeof(Filename) - 1] = 0;
+
+    status = TEC_CaptureStart(Filename);
+    if (status == CFE_STATUS_INCORRECT_STATE)
+    {
+        CFE_EVS_SendEvent(TEC_CAPTURE_ERR_EID, CFE_EVS_EventType_ERROR, "TEC: Capture already running");
+    }
+
+    if (status == CFE_SUCCESS)
+    {
+        TEC_Data.CmdCounter++;
+    }
+    else
+    {
+        TEC_Data.ErrCounter++;
+    }
+
+    return status;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         This function closes the capture file.                             */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+CFE_Status_t TEC_CaptureStopCmd(const TEC_CaptureStopCmd_t *Msg)
+{
+    TEC_Data.CmdCounter++;
+
+    TEC_CaptureStop();
+
+    return CFE_SUCCESS;
+}
@@ -31,10 +31,15 @@
 #include "tec_msg.h"
 
 CFE_Status_t TEC_SendHkCmd(const TEC_SendHkCmd_t *Msg);
+CFE_Status_t TEC_WakeupCmd(const TEC_WakeupCmd_t *Msg);
 CFE_Status_t TEC_ResetCountersCmd(const TEC_ResetCountersCmd_t *Msg);
 CFE_Status_t TEC_ProcessCmd(const TEC_ProcessCmd_t *Msg);
 CFE_Status_t TEC_NoopCmd(const TEC_NoopCmd_t *Msg);
 CFE_Status_t TEC_DisplayParamCmd(const TEC_DisplayParamCmd_t *Msg);
-CFE_Status_t TEC_ConvertTemperatureCmd(const TEC_TemperatureHkCmd_t *Msg);
+CFE_Status_t TEC_ConvertTemperatureCmd(const TEC_GetTemperatureCmd_t *Msg);
+CFE_Status_t TEC_ResetDiagCmd(const TEC_ResetDiagCmd_t *Msg);
+CFE_Status_t TEC_SelfBenchCmd(const TEC_SelfBenchCmd_t *Msg);
+CFE_Status_t TEC_CaptureStartCmd(const TEC_CaptureStartCmd_t *Msg);
+CFE_Status_t TEC_CaptureStopCmd(const TEC_CaptureStopCmd_t *Msg);
 
 #endif /* TEC_CMDS_H */
@@ -0,0 +1,173 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the TEC App diagnostics functions
+ */
+
+/*
+** Include Files:
+*/
+#include "cfe_psp.h"
+
+#include "tec.h"
+#include "tec_diag.h"
+#include "tec_msgids.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Add one latency sample to a log2 histogram                      */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void TEC_DiagAddSample(TEC_LatencyHist_t *Hist, int64 Nsec)
+{
+    uint32 Latency;
+    uint32 Scaled;
+    uint32 Bucket = 0;
+
+    if (Nsec < 0)
+    {
+        Latency = 0;
+    }
+    else if (Nsec > 0xFFFFFFFF)
+    {
+        Latency = 0xFFFFFFFF;
+    }
+    else
+    {
+        Latency = (uint32)Nsec;
+    }
+
+    Scaled = Latency;
+    while (Scaled > 1 && Bucket < (TEC_LATENCY_HIST_BUCKETS - 1))
+    {
+        Scaled >>= 1;
+        ++Bucket;
+    }
+
+    ++Hist->Count;
+    ++Hist->Bucket[Bucket];
+    if (Latency > Hist->MaxNsec)
+    {
+        Hist->MaxNsec = Latency;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Initialize the diagnostics packet                               */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_DiagInit(void)
+{
+    CFE_MSG_Init(CFE_MSG_PTR(TEC_Data.DiagTlm.TelemetryHeader), CFE_SB_ValueToMsgId(TEC_DIAG_TLM_MID),
+                 sizeof(TEC_Data.DiagTlm));
+
+    TEC_DiagReset();
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Clear all latency histograms and hardware counter totals        */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_DiagReset(void)
+{
+    uint8 HwCountersAvailable = TEC_Data.DiagTlm.Payload.HwCountersAvailable;
+
+    memset(&TEC_Data.DiagTlm.Payload, 0, sizeof(TEC_Data.DiagTlm.Payload));
+
+    TEC_Data.DiagTlm.Payload.HwCountersAvailable = HwCountersAvailable;
+
+    memset(&TEC_Data.Voter.Stats, 0, sizeof(TEC_Data.Voter.Stats));
+
+    /* The overrun count belongs to the sampling task, so only move the baseline */
+    TEC_Data.SampleOverrunBase = TEC_Data.SampleRing.Overruns;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Remember when CFE_SB_ReceiveBuffer handed over the message      */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_DiagMarkReceive(void)
+{
+    CFE_PSP_GetTime(&TEC_Data.ReceiveTime);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Record the latencies of a message whose handler just finished   */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_DiagRecord(uint8 Path, OS_time_t HandlerStart)
+{
+    OS_time_t Now;
+
+    if (Path >= TEC_DIAG_PATH_COUNT)
+    {
+        return;
+    }
+
+    CFE_PSP_GetTime(&Now);
+
+    TEC_DiagAddSample(&TEC_Data.DiagTlm.Payload.Handler[Path],
+                      OS_TimeGetTotalNanoseconds(OS_TimeSubtract(Now, HandlerStart)));
+    TEC_DiagAddSample(&TEC_Data.DiagTlm.Payload.ReceiveToDone[Path],
+                      OS_TimeGetTotalNanoseconds(OS_TimeSubtract(Now, TEC_Data.ReceiveTime)));
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Send the diagnostics packet                                     */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_DiagSend(void)
+{
+    const TEC_Core_VoterStats_t *Stats = &TEC_Data.Voter.Stats;
+    TEC_ReplicaLinkStats_t      *Link;
+    uint64                       Total;
+    uint32                       i;
+
+    TEC_Data.DiagTlm.Payload.SampleOverruns = TEC_Data.SampleRing.Overruns - TEC_Data.SampleOverrunBase;
+
+    TEC_Data.DiagTlm.Payload.ReplicaSuperseded = Stats->ReplicaSuperseded;
+    TEC_Data.DiagTlm.Payload.EpochsVoted       = Stats->EpochsVoted;
+    TEC_Data.DiagTlm.Payload.EpochsIncomplete  = Stats->EpochsIncomplete;
+    TEC_Data.DiagTlm.Payload.EpochSamplesLate  = Stats->EpochSamplesLate;
+    TEC_Data.DiagTlm.Payload.EpochsEvicted     = Stats->EpochsEvicted;
+
+    memset(TEC_Data.DiagTlm.Payload.Replica, 0, sizeof(TEC_Data.DiagTlm.Payload.Replica));
+    for (i = 0; i < TEC_Data.Voter.ReplicaCount; i++)
+    {
+        Link             = &TEC_Data.DiagTlm.Payload.Replica[i];
+        Link->Accepted   = Stats->Replica[i].Accepted;
+        Link->Lost       = Stats->Replica[i].Lost;
+        Link->Gaps       = Stats->Replica[i].Gaps;
+        Link->Duplicates = Stats->Replica[i].Duplicates;
+        Link->Late       = Stats->Replica[i].Late;
+
+        Total = (uint64)Link->Accepted + Link->Late + Link->Lost;
+
+        Link->LossPermille = (Total == 0) ? 0 : (uint16)(((uint64)Link->Lost * 1000) / Total);
+    }
+
+    CFE_SB_TimeStampMsg(CFE_MSG_PTR(TEC_Data.DiagTlm.TelemetryHeader));
+    CFE_SB_TransmitMsg(CFE_MSG_PTR(TEC_Data.DiagTlm.TelemetryHeader), true);
+}
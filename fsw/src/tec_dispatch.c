@@ -18,7 +18,10 @@
 
 /**
  * \file
- *   This file contains the source code for the TEC App.
+ *   This file contains the source code for the TEC App message dispatch.
+ *
+ *   The same dispatcher serves EDS and non-EDS builds: messages are routed
+ *   by MID, ground commands through a constant table indexed by function code.
  */
 
 /*
@@ -27,10 +30,64 @@
 #include "tec.h"
 #include "tec_dispatch.h"
 #include "tec_cmds.h"
+#include "tec_diag.h"
+#include "tec_replica.h"
+#include "tec_state.h"
 #include "tec_eventids.h"
 #include "tec_msgids.h"
 #include "tec_msg.h"
 
+#include "cfe_psp.h"
+
+/*
+** Ground command handler and the exact length of its command. Every entry
+** is called through the buffer type; TEC_CMD_HANDLER defines the wrapper
+** that passes the buffer on as the command type its handler takes.
+*/
+typedef CFE_Status_t (*TEC_CmdHandler_t)(const CFE_SB_Buffer_t *SBBufPtr);
+
+typedef struct
+{
+    TEC_CmdHandler_t Handler;
+    size_t           ExpectedLength;
+} TEC_CmdTableEntry_t;
+
+#define TEC_CMD_HANDLER(Handler, CmdType)                                    \
+    static CFE_Status_t Handler##_Dispatch(const CFE_SB_Buffer_t *SBBufPtr)  \
+    {                                                                        \
+        return Handler((const CmdType *)SBBufPtr);                           \
+    }
+
+#define TEC_CMD_ENTRY(Handler, CmdType) {Handler##_Dispatch, sizeof(CmdType)}
+
+TEC_CMD_HANDLER(TEC_NoopCmd, TEC_NoopCmd_t)
+TEC_CMD_HANDLER(TEC_ResetCountersCmd, TEC_ResetCountersCmd_t)
+TEC_CMD_HANDLER(TEC_ProcessCmd, TEC_ProcessCmd_t)
+TEC_CMD_HANDLER(TEC_DisplayParamCmd, TEC_DisplayParamCmd_t)
+TEC_CMD_HANDLER(TEC_ConvertTemperatureCmd, TEC_GetTemperatureCmd_t)
+TEC_CMD_HANDLER(TEC_ResetDiagCmd, TEC_ResetDiagCmd_t)
+TEC_CMD_HANDLER(TEC_SelfBenchCmd, TEC_SelfBenchCmd_t)
+TEC_CMD_HANDLER(TEC_CaptureStartCmd, TEC_CaptureStartCmd_t)
+TEC_CMD_HANDLER(TEC_CaptureStopCmd, TEC_CaptureStopCmd_t)
+
+/*
+** Ground command table, indexed by function code. Codes without an entry
+** have a NULL handler; the table is as long as the highest code plus one.
+*/
+static const TEC_CmdTableEntry_t TEC_CmdTable[] = {
+    [TEC_NOOP_CC]            = TEC_CMD_ENTRY(TEC_NoopCmd, TEC_NoopCmd_t),
+    [TEC_RESET_COUNTERS_CC]  = TEC_CMD_ENTRY(TEC_ResetCountersCmd, TEC_ResetCountersCmd_t),
+    [TEC_PROCESS_CC]         = TEC_CMD_ENTRY(TEC_ProcessCmd, TEC_ProcessCmd_t),
+    [TEC_DISPLAY_PARAM_CC]   = TEC_CMD_ENTRY(TEC_DisplayParamCmd, TEC_DisplayParamCmd_t),
+    [TEC_GET_TEMPERATURE_CC] = TEC_CMD_ENTRY(TEC_ConvertTemperatureCmd, TEC_GetTemperatureCmd_t),
+    [TEC_RESET_DIAG_CC]      = TEC_CMD_ENTRY(TEC_ResetDiagCmd, TEC_ResetDiagCmd_t),
+    [TEC_SELF_BENCH_CC]      = TEC_CMD_ENTRY(TEC_SelfBenchCmd, TEC_SelfBenchCmd_t),
+    [TEC_CAPTURE_START_CC]   = TEC_CMD_ENTRY(TEC_CaptureStartCmd, TEC_CaptureStartCmd_t),
+    [TEC_CAPTURE_STOP_CC]    = TEC_CMD_ENTRY(TEC_CaptureStopCmd, TEC_CaptureStopCmd_t),
+};
+
+#define TEC_CMD_TABLE_SIZE (sizeof(TEC_CmdTable) / sizeof(TEC_CmdTable[0]))
+
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
 /*                                                                            */
 /* Verify command packet length                                               */
@@ -68,110 +125,55 @@ bool TEC_VerifyCmdLength(const CFE_MSG_Message_t *MsgPtr, size_t ExpectedLength)
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
 /*                                                                            */
-/* TEC ground commands                                                     */
+/* Verify the length of a packet from a peer                                  */
 /*                                                                            */
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
-void TEC_ProcessGroundCommand(const CFE_SB_Buffer_t *SBBufPtr)
+static bool TEC_VerifyPeerLength(const CFE_MSG_Message_t *MsgPtr, size_t ExpectedLength)
 {
-    CFE_MSG_FcnCode_t CommandCode = 0;
+    size_t ActualLength = 0;
 
-    CFE_MSG_GetFcnCode(&SBBufPtr->Msg, &CommandCode);
+    CFE_MSG_GetSize(MsgPtr, &ActualLength);
 
-    /*
-    ** Process TEC app ground commands
-    */
-    switch (CommandCode)
+    /* Telemetry from another node, not a ground command; dropped and counted with the replica traffic */
+    if (ExpectedLength != ActualLength)
     {
-        case TEC_NOOP_CC:
-            if (TEC_VerifyCmdLength(&SBBufPtr->Msg, sizeof(TEC_NoopCmd_t)))
-            {
-                TEC_NoopCmd((const TEC_NoopCmd_t *)SBBufPtr);
-            }
-            break;
-
-        case TEC_RESET_COUNTERS_CC:
-            if (TEC_VerifyCmdLength(&SBBufPtr->Msg, sizeof(TEC_ResetCountersCmd_t)))
-            {
-                TEC_ResetCountersCmd((const TEC_ResetCountersCmd_t *)SBBufPtr);
-            }
-            break;
-
-        case TEC_PROCESS_CC:
-            if (TEC_VerifyCmdLength(&SBBufPtr->Msg, sizeof(TEC_ProcessCmd_t)))
-            {
-                TEC_ProcessCmd((const TEC_ProcessCmd_t *)SBBufPtr);
-            }
-            break;
-
-        case TEC_DISPLAY_PARAM_CC:
-            if (TEC_VerifyCmdLength(&SBBufPtr->Msg, sizeof(TEC_DisplayParamCmd_t)))
-            {
-                TEC_DisplayParamCmd((const TEC_DisplayParamCmd_t *)SBBufPtr);
-            }
-            break;
-
-        case TEC_GET_TEMPERATURE_CC:
-            if (TEC_VerifyCmdLength(&SBBufPtr->Msg, sizeof(TEC_TemperatureHkCmd_t)))
-            {
-                TEC_ConvertTemperatureCmd((const TEC_TemperatureHkCmd_t *)SBBufPtr);
-            }
-            break;
-
-        /* default case already found during FC vs length test */
-        default:
-            CFE_EVS_SendEvent(TEC_CC_ERR_EID, CFE_EVS_EventType_ERROR, "Invalid ground command code: CC = %d",
-                              CommandCode);
-            break;
+        ++TEC_Data.DiagTlm.Payload.Pipe[TEC_PIPE_REPLICA].Rejected;
+        return false;
     }
-}
 
+    return true;
+}
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
 /*                                                                            */
-/* TEC Majority voting on all Hk Temperature measurements                     */
+/* TEC ground commands                                                     */
 /*                                                                            */
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
-
-static void TEC_MajorityVoter(const CFE_SB_Buffer_t *SBBufPtr, uint8 RemoteCpuIndex)
+void TEC_ProcessGroundCommand(const CFE_SB_Buffer_t *SBBufPtr)
 {
-    const TEC_HkTlm_t *Msg = (const TEC_HkTlm_t *)SBBufPtr;
-    uint32 RemoteTemperature = Msg->Payload.Temperature;
-    // char RemoteUnit = Msg->Payload.Unit;
-
-    TEC_Data.RemoteTemperatures[RemoteCpuIndex] = RemoteTemperature;
-
-    if (TEC_Data.TemperatureHk == TEC_Data.RemoteTemperatures[0] || TEC_Data.TemperatureHk == TEC_Data.RemoteTemperatures[1]) {
-        TEC_Data.Temperature = TEC_Data.TemperatureHk;
-    } else if (TEC_Data.RemoteTemperatures[0] == TEC_Data.RemoteTemperatures[1]) {
-        TEC_Data.Temperature = TEC_Data.RemoteTemperatures[0];
-        CFE_EVS_SendEvent(TEC_MID_ERR_EID, CFE_EVS_EventType_ERROR,
-                              "TEC: I lost the vote! My temperature is %d, but %d won...", TEC_Data.TemperatureHk, TEC_Data.Temperature);
-    } else {
-        // TEC_Data.Temperature = -1;
-        CFE_EVS_SendEvent(TEC_MID_ERR_EID, CFE_EVS_EventType_ERROR,
-                              "TEC: Catastrophic failure... couldnt find majority!");
-       /* 
-       TODO: Handle Error case...
-       For example raise some events or alerts, or request a retransmission from the faulty node
-        */
-
-    }
-
-    // CFE_EVS_SendEvent(TEC_VALUE_INF_EID, CFE_EVS_EventType_INFORMATION,
-    //                     "TEC: Temps local %d A %d B %d\n", TEC_Data.TemperatureHk, TEC_Data.RemoteTemperatures[0], TEC_Data.RemoteTemperatures[1]);
+    CFE_MSG_FcnCode_t          CommandCode = 0;
+    const TEC_CmdTableEntry_t *Entry;
 
-    CFE_EVS_SendEvent(TEC_VALUE_INF_EID, CFE_EVS_EventType_INFORMATION,
-                        "TEC: The voted Temperature is %d\n", TEC_Data.Temperature);
-
-    // TODO: Further use ElectedTemperature as the official TO/Downlink temperature...
+    CFE_MSG_GetFcnCode(&SBBufPtr->Msg, &CommandCode);
 
     /*
-    TODO: Implement a counter that counts if the local node failed and lost the vote.
-    If the lost_counter passes a predefined threshold, we can mask it out (add field in TEC_Data and add to Hk message).
-    Then, in the majority voter of the remote nodes, we do not take this node into consideration anymore. reducing it to a simplex module. Then its 1 vs 1...
+    ** Process TEC app ground commands, unknown codes are rejected by
+    ** the bounds check and the empty slots in the table
     */
-}
+    if (CommandCode >= TEC_CMD_TABLE_SIZE || TEC_CmdTable[CommandCode].Handler == NULL)
+    {
+        CFE_EVS_SendEvent(TEC_CC_ERR_EID, CFE_EVS_EventType_ERROR, "Invalid ground command code: CC = %d",
+                          CommandCode);
+        TEC_Data.ErrCounter++;
+        return;
+    }
 
+    Entry = &TEC_CmdTable[CommandCode];
+    if (TEC_VerifyCmdLength(&SBBufPtr->Msg, Entry->ExpectedLength))
+    {
+        Entry->Handler(SBBufPtr);
+    }
+}
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
 /*                                                                            */
@@ -183,27 +185,58 @@ static void TEC_MajorityVoter(const CFE_SB_Buffer_t *SBBufPtr, uint8 RemoteCpuIn
 void TEC_TaskPipe(const CFE_SB_Buffer_t *SBBufPtr)
 {
     CFE_SB_MsgId_t MsgId = CFE_SB_INVALID_MSG_ID;
+    uint8          Path  = TEC_DIAG_PATH_COUNT;
+    uint8          ReplicaIndex;
+    OS_time_t      HandlerStart;
 
     CFE_MSG_GetMsgId(&SBBufPtr->Msg, &MsgId);
 
+    CFE_PSP_GetTime(&HandlerStart);
+
     switch (CFE_SB_MsgIdToValue(MsgId))
     {
         case TEC_CMD_MID:
+            Path = TEC_DIAG_PATH_CMD;
             TEC_ProcessGroundCommand(SBBufPtr);
             break;
 
         case TEC_SEND_HK_MID:
+            Path = TEC_DIAG_PATH_SEND_HK;
             TEC_SendHkCmd((const TEC_SendHkCmd_t *)SBBufPtr);
             break;
-        case CPUA_HK_MID:
-            TEC_MajorityVoter(SBBufPtr, 0);
+        case TEC_WAKEUP_MID:
+            TEC_WakeupCmd((const TEC_WakeupCmd_t *)SBBufPtr);
             break;
-        case CPUB_HK_MID:
-            TEC_MajorityVoter(SBBufPtr, 1);
+
+        case TEC_STATE_REQ_MID:
+            Path = TEC_DIAG_PATH_REPLICA;
+            if (TEC_VerifyPeerLength(&SBBufPtr->Msg, sizeof(TEC_StateRequestTlm_t)))
+            {
+                TEC_StateRequestReceived((const TEC_StateRequestTlm_t *)SBBufPtr);
+            }
+            break;
+        case TEC_STATE_RSP_MID:
+            Path = TEC_DIAG_PATH_REPLICA;
+            if (TEC_VerifyPeerLength(&SBBufPtr->Msg, sizeof(TEC_StateResponseTlm_t)))
+            {
+                TEC_StateResponseReceived((const TEC_StateResponseTlm_t *)SBBufPtr);
+            }
             break;
         default:
-            CFE_EVS_SendEvent(TEC_MID_ERR_EID, CFE_EVS_EventType_ERROR,
-                              "TEC: invalid command packet,MID = 0x%x", (unsigned int)CFE_SB_MsgIdToValue(MsgId));
+            /* Replica telemetry, looked up in the replica map */
+            if (TEC_ReplicaLookup(MsgId, &ReplicaIndex))
+            {
+                Path = TEC_DIAG_PATH_REPLICA;
+                TEC_ReplicaReceive(ReplicaIndex, SBBufPtr);
+            }
+            else
+            {
+                CFE_EVS_SendEvent(TEC_MID_ERR_EID, CFE_EVS_EventType_ERROR,
+                                  "TEC: invalid command packet,MID = 0x%x", (unsigned int)CFE_SB_MsgIdToValue(MsgId));
+                TEC_Data.ErrCounter++;
+            }
             break;
     }
+
+    TEC_DiagRecord(Path, HandlerStart);
 }
@@ -0,0 +1,225 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the TEC App hardware performance
+ *   counters.
+ *
+ * On Linux, cycles, instructions, cache misses and branch misses of the TEC
+ * task are read from one perf_event_open group before and after each stage
+ * and the differences are added to the stage totals of the diagnostics
+ * packet. If the counters cannot be opened (no permission, no PMU, not
+ * Linux) they stay off and the stage markers do nothing.
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* syscall() */
+#endif
+
+/*
+** Include Files:
+*/
+#include "tec.h"
+#include "tec_hwcount.h"
+#include "tec_eventids.h"
+
+#if TEC_HWCOUNT_ENABLED
+
+#ifdef __linux__
+
+#include <errno.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define TEC_HWCOUNT_EVENT_COUNT 4
+
+/*
+** Counter events, in the order of the TEC_HwCounters_t fields
+*/
+static const uint64 TEC_HwCountEvents[TEC_HWCOUNT_EVENT_COUNT] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                                                  PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+
+static int    TEC_HwCountFd[TEC_HWCOUNT_EVENT_COUNT] = {-1, -1, -1, -1};
+static uint64 TEC_HwCountStart[TEC_HWCOUNT_STAGE_COUNT][TEC_HWCOUNT_EVENT_COUNT];
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Close all counters and mark them unavailable                    */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void TEC_HwCountShutdown(void)
+{
+    int i;
+
+    for (i = 0; i < TEC_HWCOUNT_EVENT_COUNT; i++)
+    {
+        if (TEC_HwCountFd[i] >= 0)
+        {
+            close(TEC_HwCountFd[i]);
+            TEC_HwCountFd[i] = -1;
+        }
+    }
+
+    TEC_Data.DiagTlm.Payload.HwCountersAvailable = false;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Read all counters of the group in one system call               */
+/* A failed read turns the counters off for the rest of the run;   */
+/* the event goes out once since the stage markers stop reading.   */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static bool TEC_HwCountRead(uint64 Values[TEC_HWCOUNT_EVENT_COUNT])
+{
+    struct
+    {
+        uint64 Nr;
+        uint64 Value[TEC_HWCOUNT_EVENT_COUNT];
+    } Group;
+    ssize_t Length;
+
+    Length = read(TEC_HwCountFd[0], &Group, sizeof(Group));
+    if (Length < 0)
+    {
+        CFE_EVS_SendEvent(TEC_HWCOUNT_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "TEC: Hardware counters off, read errno %d", errno);
+        TEC_HwCountShutdown();
+        return false;
+    }
+
+    if (Length != (ssize_t)sizeof(Group) || Group.Nr != TEC_HWCOUNT_EVENT_COUNT)
+    {
+        CFE_EVS_SendEvent(TEC_HWCOUNT_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "TEC: Hardware counters off, read %ld of %lu bytes", (long)Length,
+                          (unsigned long)sizeof(Group));
+        TEC_HwCountShutdown();
+        return false;
+    }
+
+    memcpy(Values, Group.Value, sizeof(Group.Value));
+    return true;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Open the counter group for the calling (TEC main) task          */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_HwCountInit(void)
+{
+    struct perf_event_attr Attr;
+    int                    i;
+
+    for (i = 0; i < TEC_HWCOUNT_EVENT_COUNT; i++)
+    {
+        memset(&Attr, 0, sizeof(Attr));
+        Attr.size           = sizeof(Attr);
+        Attr.type           = PERF_TYPE_HARDWARE;
+        Attr.config         = TEC_HwCountEvents[i];
+        Attr.disabled       = (i == 0);
+        Attr.exclude_kernel = 1;
+        Attr.exclude_hv     = 1;
+        Attr.read_format    = PERF_FORMAT_GROUP;
+
+        TEC_HwCountFd[i] = (int)syscall(__NR_perf_event_open, &Attr, 0, -1, TEC_HwCountFd[0], 0);
+        if (TEC_HwCountFd[i] < 0)
+        {
+            CFE_EVS_SendEvent(TEC_HWCOUNT_INF_EID, CFE_EVS_EventType_INFORMATION,
+                              "TEC: Hardware counters off, perf_event_open errno %d", errno);
+            TEC_HwCountShutdown();
+            return;
+        }
+    }
+
+    ioctl(TEC_HwCountFd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(TEC_HwCountFd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+
+    TEC_Data.DiagTlm.Payload.HwCountersAvailable = true;
+
+    CFE_EVS_SendEvent(TEC_HWCOUNT_INF_EID, CFE_EVS_EventType_INFORMATION, "TEC: Hardware counters on");
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Snapshot the counters at the start of a stage                   */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_HwCountBegin(uint8 Stage)
+{
+    if (!TEC_Data.DiagTlm.Payload.HwCountersAvailable)
+    {
+        return;
+    }
+
+    TEC_HwCountRead(TEC_HwCountStart[Stage]);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Add the counts since TEC_HwCountBegin to the stage totals       */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_HwCountEnd(uint8 Stage)
+{
+    TEC_HwCounters_t *Totals;
+    uint64            Now[TEC_HWCOUNT_EVENT_COUNT];
+
+    if (!TEC_Data.DiagTlm.Payload.HwCountersAvailable)
+    {
+        return;
+    }
+
+    if (!TEC_HwCountRead(Now))
+    {
+        return;
+    }
+
+    Totals = &TEC_Data.DiagTlm.Payload.HwCounters[Stage];
+    Totals->Cycles += Now[0] - TEC_HwCountStart[Stage][0];
+    Totals->Instructions += Now[1] - TEC_HwCountStart[Stage][1];
+    Totals->CacheMisses += Now[2] - TEC_HwCountStart[Stage][2];
+    Totals->BranchMisses += Now[3] - TEC_HwCountStart[Stage][3];
+    ++Totals->Samples;
+}
+
+#else /* not __linux__ */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* No counter interface on this OS                                 */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_HwCountInit(void)
+{
+    TEC_Data.DiagTlm.Payload.HwCountersAvailable = false;
+
+    CFE_EVS_SendEvent(TEC_HWCOUNT_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "TEC: Hardware counters off, not supported on this OS");
+}
+
+void TEC_HwCountBegin(uint8 Stage) {}
+
+void TEC_HwCountEnd(uint8 Stage) {}
+
+#endif /* __linux__ */
+
+#endif /* TEC_HWCOUNT_ENABLED */
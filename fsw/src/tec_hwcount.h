@@ -0,0 +1,43 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *   This file contains the prototypes for the TEC App hardware performance
+ *   counter functions
+ */
+
+#ifndef TEC_HWCOUNT_H
+#define TEC_HWCOUNT_H
+
+/*
+** Required header files.
+*/
+#include "tec.h"
+
+#if TEC_HWCOUNT_ENABLED
+void TEC_HwCountInit(void);
+void TEC_HwCountBegin(uint8 Stage);
+void TEC_HwCountEnd(uint8 Stage);
+#else
+#define TEC_HwCountInit()       ((void)0)
+#define TEC_HwCountBegin(Stage) ((void)0)
+#define TEC_HwCountEnd(Stage)   ((void)0)
+#endif
+
+#endif /* TEC_HWCOUNT_H */
@@ -0,0 +1,171 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the TEC App software bus pipe functions
+ *
+ *   Ground commands and replica telemetry are kept on separate pipes with a
+ *   message limit per MID, so a burst of replica traffic cannot crowd out
+ *   commands. The main loop services the pipes in TEC_PIPE_* order.
+ */
+
+/*
+** Include Files:
+*/
+#include "tec.h"
+#include "tec_eventids.h"
+#include "tec_msgids.h"
+#include "tec_pipes.h"
+
+#include "tec_core.h"
+
+/*
+** Every fixed message TEC subscribes to, the pipe it goes to, its message
+** limit and whether its sequence count is checked for losses; that is not
+** possible for message IDs every replica sends on, as their counts
+** interleave. Replica telemetry is subscribed from the configuration
+** table, see tec_replica.c.
+*/
+typedef struct
+{
+    CFE_SB_MsgId_Atom_t MsgId;
+    uint8               Pipe;
+    uint16              MsgLim;
+    bool                TrackSeq;
+} TEC_Subscription_t;
+
+static const TEC_Subscription_t TEC_Subscriptions[] = {
+    {TEC_SEND_HK_MID, TEC_PIPE_CMD, TEC_SEND_HK_MSG_LIM, true},
+    {TEC_WAKEUP_MID, TEC_PIPE_CMD, TEC_WAKEUP_MSG_LIM, true},
+    {TEC_CMD_MID, TEC_PIPE_CMD, TEC_CMD_MSG_LIM, true},
+    {TEC_STATE_REQ_MID, TEC_PIPE_REPLICA, TEC_STATE_MSG_LIM, false},
+    {TEC_STATE_RSP_MID, TEC_PIPE_REPLICA, TEC_STATE_MSG_LIM, false},
+};
+
+#define TEC_SUBSCRIPTION_COUNT (sizeof(TEC_Subscriptions) / sizeof(TEC_Subscriptions[0]))
+
+CompileTimeAssert(TEC_SUBSCRIPTION_COUNT <= TEC_MAX_SUBSCRIPTIONS, TecSubscriptionTableTooLarge);
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Create the replica pipe                                         */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+CFE_Status_t TEC_PipesInit(void)
+{
+    CFE_Status_t status;
+
+    status = CFE_SB_CreatePipe(&TEC_Data.ReplicaPipe, TEC_REPLICA_PIPE_DEPTH, TEC_REPLICA_PIPE_NAME);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(TEC_CR_PIPE_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "TEC App: Error creating SB Replica Pipe, RC = 0x%08lX", (unsigned long)status);
+    }
+
+    return status;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Subscribe to every fixed message                                */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+CFE_Status_t TEC_PipesSubscribe(void)
+{
+    CFE_Status_t status = CFE_SUCCESS;
+    uint32       i;
+
+    for (i = 0; i < TEC_SUBSCRIPTION_COUNT && status == CFE_SUCCESS; i++)
+    {
+        CFE_EVS_SendDbg(TEC_INIT_INF_EID, "Subscribing to 0x%04x", (unsigned int)TEC_Subscriptions[i].MsgId);
+        status = CFE_SB_SubscribeEx(CFE_SB_ValueToMsgId(TEC_Subscriptions[i].MsgId),
+                                    TEC_PipeId(TEC_Subscriptions[i].Pipe), CFE_SB_DEFAULT_QOS,
+                                    TEC_Subscriptions[i].MsgLim);
+        if (status != CFE_SUCCESS)
+        {
+            CFE_EVS_SendEvent(TEC_SUB_CMD_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "TEC App: Error Subscribing to 0x%04x, RC = 0x%08lX",
+                              (unsigned int)TEC_Subscriptions[i].MsgId, (unsigned long)status);
+        }
+    }
+
+    return status;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Pipe ID of one of the TEC_PIPE_* pipes                          */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+CFE_SB_PipeId_t TEC_PipeId(uint8 Pipe)
+{
+    if (Pipe == TEC_PIPE_REPLICA)
+    {
+        return TEC_Data.ReplicaPipe;
+    }
+
+    return TEC_Data.CommandPipe;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Count a received message and any lost ahead of it               */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_PipesAccount(uint8 Pipe, const CFE_SB_Buffer_t *SBBufPtr)
+{
+    CFE_SB_MsgId_t          MsgId = CFE_SB_INVALID_MSG_ID;
+    CFE_MSG_SequenceCount_t SeqCnt;
+    uint32                  i;
+
+    if (Pipe >= TEC_PIPE_COUNT)
+    {
+        return;
+    }
+
+    ++TEC_Data.DiagTlm.Payload.Pipe[Pipe].Received;
+
+    /*
+    ** SB drops packets over the MID limit without telling the receiver,
+    ** so losses are estimated from gaps in each stream's sequence count.
+    ** Replica streams are tracked per replica by TEC_ReplicaReceive.
+    */
+    CFE_MSG_GetMsgId(&SBBufPtr->Msg, &MsgId);
+    CFE_MSG_GetSequenceCount(&SBBufPtr->Msg, &SeqCnt);
+
+    for (i = 0; i < TEC_SUBSCRIPTION_COUNT; i++)
+    {
+        if (TEC_Subscriptions[i].MsgId == CFE_SB_MsgIdToValue(MsgId))
+        {
+            if (!TEC_Subscriptions[i].TrackSeq)
+            {
+                break;
+            }
+
+            if (TEC_Data.SubSeqValid[i])
+            {
+                TEC_Data.DiagTlm.Payload.Pipe[Pipe].Dropped += TEC_Core_SequenceGap(TEC_Data.SubSeq[i], SeqCnt);
+            }
+
+            TEC_Data.SubSeq[i]      = SeqCnt;
+            TEC_Data.SubSeqValid[i] = true;
+            break;
+        }
+    }
+}
@@ -0,0 +1,160 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the TEC App replica membership functions
+ *
+ *   The remote replicas are the exchange message IDs listed in the
+ *   configuration table. Each is subscribed on the replica pipe and mapped to a replica
+ *   index through an open-addressing table, so routing an incoming packet
+ *   costs the same for three nodes or thirty.
+ */
+
+/*
+** Include Files:
+*/
+#include "tec.h"
+#include "tec_eventids.h"
+#include "tec_replica.h"
+#include "tec_capture.h"
+
+#include "tec_core.h"
+
+/* Keep the map at most half full so probe sequences stay short */
+CompileTimeAssert(TEC_MAX_REPLICAS <= TEC_CORE_IDMAP_SLOTS / 2, TecReplicaMapTooSmall);
+CompileTimeAssert(TEC_MAX_REPLICAS <= TEC_CORE_VOTER_REPLICAS, TecReplicasFitVoteState);
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Replace the replica membership with the configuration table's   */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+CFE_Status_t TEC_ReplicaConfigure(void)
+{
+    CFE_Status_t        status = CFE_SUCCESS;
+    CFE_SB_MsgId_Atom_t MsgId;
+    uint32              ReplicaId[TEC_MAX_REPLICAS];
+    uint32              Count = 0;
+    uint32              i;
+
+    for (i = 0; i < TEC_Data.Voter.ReplicaCount; i++)
+    {
+        CFE_SB_Unsubscribe(CFE_SB_ValueToMsgId(TEC_Data.Voter.ReplicaId[i]), TEC_Data.ReplicaPipe);
+    }
+
+    /* The table validation function has already checked count and uniqueness */
+    for (i = 0; i < TEC_Data.Config.ReplicaCount && i < TEC_MAX_REPLICAS; i++)
+    {
+        MsgId = TEC_Data.Config.ReplicaMsgId[i];
+
+        status = CFE_SB_SubscribeEx(CFE_SB_ValueToMsgId(MsgId), TEC_Data.ReplicaPipe, CFE_SB_DEFAULT_QOS,
+                                    TEC_REPLICA_MSG_LIM);
+        if (status != CFE_SUCCESS)
+        {
+            CFE_EVS_SendEvent(TEC_REPLICA_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "TEC App: Error Subscribing to replica 0x%04x, RC = 0x%08lX", (unsigned int)MsgId,
+                              (unsigned long)status);
+            break;
+        }
+
+        ReplicaId[Count] = MsgId;
+        ++Count;
+    }
+
+    /*
+    ** A membership is taken whole or not at all; vote alone until the next
+    ** load. The event above reports the failure, the app carries on.
+    */
+    if (status != CFE_SUCCESS)
+    {
+        for (i = 0; i < Count; i++)
+        {
+            CFE_SB_Unsubscribe(CFE_SB_ValueToMsgId(ReplicaId[i]), TEC_Data.ReplicaPipe);
+        }
+        Count  = 0;
+        status = CFE_SUCCESS;
+    }
+
+    /* Epoch numbering follows the sample period, so the vote starts afresh */
+    TEC_Core_VoterSetMembers(&TEC_Data.Voter, ReplicaId, Count);
+    TEC_CaptureVoter();
+
+    CFE_EVS_SendEvent(TEC_REPLICA_INF_EID, CFE_EVS_EventType_INFORMATION, "TEC App: Voting with %lu remote replica(s)",
+                      (unsigned long)TEC_Data.Voter.ReplicaCount);
+
+    return status;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Replica index of a message ID, if it belongs to a replica       */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool TEC_ReplicaLookup(CFE_SB_MsgId_t MsgId, uint8 *ReplicaIndex)
+{
+    return TEC_Core_VoterLookup(&TEC_Data.Voter, CFE_SB_MsgIdToValue(MsgId), ReplicaIndex);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Take the sample from a replica exchange packet, dropping        */
+/* packets of the wrong length, duplicates and late packets        */
+/* before they reach the voter                                     */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_ReplicaReceive(uint8 ReplicaIndex, const CFE_SB_Buffer_t *SBBufPtr)
+{
+    const TEC_Exchange_Payload_t *Payload = &((const TEC_ExchangeTlm_t *)SBBufPtr)->Payload;
+    CFE_MSG_SequenceCount_t       SeqCnt;
+    TEC_PipeStats_t              *Pipe = &TEC_Data.DiagTlm.Payload.Pipe[TEC_PIPE_REPLICA];
+    size_t                        Size = 0;
+    uint32                        Missed;
+
+    /*
+    ** Whatever arrives on a replica's message ID is read as an exchange
+    ** packet, so a packet of another layout must not get any further
+    */
+    CFE_MSG_GetSize(&SBBufPtr->Msg, &Size);
+    if (Size != sizeof(TEC_ExchangeTlm_t))
+    {
+        ++Pipe->Rejected;
+        return;
+    }
+
+    CFE_MSG_GetSequenceCount(&SBBufPtr->Msg, &SeqCnt);
+
+    switch (TEC_Core_VoterRemote(&TEC_Data.Voter, ReplicaIndex, (uint16)SeqCnt,
+                                 (const TEC_Core_ExchangeSample_t *)Payload, &Missed))
+    {
+        case TEC_CORE_SEQ_GAP:
+            Pipe->Dropped += Missed;
+            break;
+
+        case TEC_CORE_SEQ_LATE:
+            /* Counted as dropped when the gap opened */
+            if (Pipe->Dropped > 0)
+            {
+                --Pipe->Dropped;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
@@ -0,0 +1,344 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the TEC App sampling child task
+ *
+ *   The child task reads the sensor at the period given in the configuration
+ *   table and hands timestamped samples to the main task through a lock-free
+ *   single-producer/single-consumer ring, so sampling keeps its own cadence
+ *   no matter how busy the command pipe is. Each sample is also published
+ *   to the other replicas straight away, so voting on the other nodes
+ *   follows the sampling rate rather than the housekeeping schedule.
+ */
+
+/*
+** Include Files:
+*/
+#include "cfe_psp.h"
+
+#include "tec.h"
+#include "tec_eventids.h"
+#include "tec_sampler.h"
+#include "tec_udp.h"
+#include "tec_voter.h"
+
+#include "tec_core.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Prime the newest sample and start the sampling child task       */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+CFE_Status_t TEC_SamplerInit(void)
+{
+    CFE_Status_t status;
+    int32        OsStatus;
+
+    TEC_Core_RingInit(&TEC_Data.SampleRing);
+
+    /* Have a valid value before the first sample arrives */
+    TEC_Data.SampleRaw  = TEC_Core_ReadRawSensor();
+    TEC_Data.SampleTime = CFE_TIME_GetTime();
+
+    /* No quality matches all ones, so the first packet marks every channel changed */
+    CFE_MSG_Init(CFE_MSG_PTR(TEC_Data.ExchangeTlm.TelemetryHeader),
+                 CFE_SB_ValueToMsgId(TEC_Data.Config.LocalExchangeMsgId), sizeof(TEC_Data.ExchangeTlm));
+    TEC_Data.ExchangeTlm.Payload.Raw     = 0xFFFFFFFF;
+    TEC_Data.ExchangeTlm.Payload.Quality = 0xFF;
+    TEC_Data.ExchangeOverruns            = TEC_Data.SampleRing.Overruns;
+
+    OsStatus = OS_MutSemCreate(&TEC_Data.SampleMutexId, TEC_SAMPLE_MUTEX_NAME, 0);
+    if (OsStatus != OS_SUCCESS)
+    {
+        CFE_EVS_SendEvent(TEC_SAMPLER_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "TEC App: Error creating sampling mutex, RC = %ld", (long)OsStatus);
+        status = CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+    else
+    {
+        /* The configuration was loaded before there was a mutex to publish it under */
+        TEC_SamplerConfigure();
+
+        status = CFE_ES_CreateChildTask(&TEC_Data.SampleTaskId, TEC_SAMPLE_TASK_NAME, TEC_SampleTask,
+                                        CFE_ES_TASK_STACK_ALLOCATE, TEC_SAMPLE_TASK_STACK_SIZE,
+                                        TEC_SAMPLE_TASK_PRIORITY, 0);
+        if (status != CFE_SUCCESS)
+        {
+            CFE_EVS_SendEvent(TEC_SAMPLER_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "TEC App: Error creating sampling task, RC = 0x%08lX", (unsigned long)status);
+        }
+    }
+
+    return status;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Publish the sampling settings of the active configuration       */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_SamplerConfigure(void)
+{
+    TEC_SamplerLock();
+
+    TEC_Data.SampleConfig.PeriodMsec    = TEC_Data.Config.SamplePeriodMsec;
+    TEC_Data.SampleConfig.PhaseMsec     = TEC_Data.Config.SamplePhaseMsec;
+    TEC_Data.SampleConfig.Mode          = TEC_Data.Config.SampleMode;
+    TEC_Data.SampleConfig.ExchangeMsgId = TEC_Data.Config.LocalExchangeMsgId;
+
+    TEC_SamplerUnlock();
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Take and give the state shared with the sampling task           */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_SamplerLock(void)
+{
+    /* Before the child task is started there is nobody to race with */
+    if (OS_ObjectIdDefined(TEC_Data.SampleMutexId))
+    {
+        OS_MutSemTake(TEC_Data.SampleMutexId);
+    }
+}
+
+void TEC_SamplerUnlock(void)
+{
+    if (OS_ObjectIdDefined(TEC_Data.SampleMutexId))
+    {
+        OS_MutSemGive(TEC_Data.SampleMutexId);
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* cFE time in microseconds                                        */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static uint64 TEC_SamplerTimeUsec(CFE_TIME_SysTime_t Time)
+{
+    return (uint64)Time.Seconds * 1000000 + CFE_TIME_Sub2MicroSecs(Time.Subseconds);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Free running: wait for the next period of this task's own clock */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void TEC_SamplerWaitFreeRun(const TEC_SamplerConfig_t *Config, OS_time_t *Deadline, TEC_Core_Sample_t *Sample)
+{
+    CFE_TIME_SysTime_t Now;
+    OS_time_t          Current;
+    int64              RemainingMsec;
+
+    /*
+    ** Pace on absolute deadlines so the period does not drift by the
+    ** time spent sampling; after an overrun, restart from now
+    */
+    *Deadline = OS_TimeAdd(*Deadline, OS_TimeFromTotalMilliseconds(Config->PeriodMsec));
+    CFE_PSP_GetTime(&Current);
+    RemainingMsec = OS_TimeGetTotalMilliseconds(OS_TimeSubtract(*Deadline, Current));
+    if (RemainingMsec > 0)
+    {
+        OS_TaskDelay((uint32)RemainingMsec);
+    }
+    else
+    {
+        *Deadline = Current;
+    }
+
+    CFE_PSP_GetTime(&Current);
+    Now = CFE_TIME_GetTime();
+
+    Sample->Seconds    = Now.Seconds;
+    Sample->Subseconds = Now.Subseconds;
+    Sample->Epoch      = TEC_Core_EpochOf(Now.Seconds, Now.Subseconds, Config->PeriodMsec);
+    Sample->SkewUsec   = (int32)OS_TimeGetTotalMicroseconds(OS_TimeSubtract(Current, *Deadline));
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Time aligned: wait for the next instant of the grid in cFE time */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void TEC_SamplerWaitAligned(const TEC_SamplerConfig_t *Config, TEC_Core_Sample_t *Sample)
+{
+    uint64 NowUsec;
+    uint64 DueUsec;
+
+    NowUsec = TEC_SamplerTimeUsec(CFE_TIME_GetTime());
+    DueUsec = TEC_Core_NextAlignedUsec(NowUsec, Config->PeriodMsec, Config->PhaseMsec);
+
+    /* Round up so the task does not wake before the instant is due */
+    OS_TaskDelay((uint32)((DueUsec - NowUsec + 999) / 1000));
+
+    NowUsec = TEC_SamplerTimeUsec(CFE_TIME_GetTime());
+
+    /*
+    ** Stamp the sample with the grid instant, which every node shares, so
+    ** it falls in the same epoch on all of them; the skew keeps the truth.
+    ** The epoch is counted from the instant itself, not from the subseconds,
+    ** which may have been rounded down to just before the grid instant.
+    */
+    Sample->Seconds    = (uint32)(DueUsec / 1000000);
+    Sample->Subseconds = CFE_TIME_Micro2SubSecs((uint32)(DueUsec % 1000000));
+    Sample->Epoch      = (uint32)(DueUsec / ((uint64)Config->PeriodMsec * 1000));
+    Sample->SkewUsec   = (int32)(int64)(NowUsec - DueUsec);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Publish a sample to the other replicas                          */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void TEC_SamplerPublish(const TEC_SamplerConfig_t *Config, const TEC_Core_Sample_t *Sample)
+{
+    TEC_Exchange_Payload_t *Payload = &TEC_Data.ExchangeTlm.Payload;
+    CFE_TIME_SysTime_t      SampleTime;
+    uint8                   Quality = 0;
+    uint8                   ChangedMask;
+
+    if (Sample->Raw <= TEC_CORE_RAW_MAX)
+    {
+        Quality |= TEC_EXCHANGE_QUALITY_VALID;
+    }
+    if (Config->Mode == TEC_SAMPLE_MODE_TIME_ALIGNED)
+    {
+        Quality |= TEC_EXCHANGE_QUALITY_ALIGNED;
+    }
+    if (TEC_Data.SampleRing.Overruns != TEC_Data.ExchangeOverruns)
+    {
+        Quality |= TEC_EXCHANGE_QUALITY_OVERRUN;
+        TEC_Data.ExchangeOverruns = TEC_Data.SampleRing.Overruns;
+    }
+
+    ChangedMask = 0;
+    if (Sample->Raw != Payload->Raw)
+    {
+        ChangedMask |= TEC_EXCHANGE_CHANNEL_RAW;
+    }
+    if (Quality != Payload->Quality)
+    {
+        ChangedMask |= TEC_EXCHANGE_CHANNEL_QUALITY;
+    }
+
+    SampleTime.Seconds    = Sample->Seconds;
+    SampleTime.Subseconds = Sample->Subseconds;
+
+    Payload->Epoch       = Sample->Epoch;
+    Payload->Raw         = Sample->Raw;
+    Payload->Quality     = Quality;
+    Payload->ChangedMask = ChangedMask;
+
+    /*
+    ** The header carries the node's exchange message ID from the table, the
+    ** sample time rather than the send time, and a sequence count of its own
+    ** so receivers track the stream the same way whichever transport carried it
+    */
+    CFE_MSG_SetMsgId(CFE_MSG_PTR(TEC_Data.ExchangeTlm.TelemetryHeader), CFE_SB_ValueToMsgId(Config->ExchangeMsgId));
+    CFE_MSG_SetMsgTime(CFE_MSG_PTR(TEC_Data.ExchangeTlm.TelemetryHeader), SampleTime);
+    CFE_MSG_SetSequenceCount(CFE_MSG_PTR(TEC_Data.ExchangeTlm.TelemetryHeader), TEC_Data.ExchangeSeq);
+    TEC_Data.ExchangeSeq = CFE_MSG_GetNextSequenceCount(TEC_Data.ExchangeSeq);
+
+    if (!TEC_UdpSend(&TEC_Data.ExchangeTlm))
+    {
+        CFE_SB_TransmitMsg(CFE_MSG_PTR(TEC_Data.ExchangeTlm.TelemetryHeader), false);
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Sampling child task entry point                                 */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_SampleTask(void)
+{
+    TEC_SamplerConfig_t Config;
+    TEC_Core_Sample_t   Sample;
+    OS_time_t           Deadline;
+
+    CFE_PSP_GetTime(&Deadline);
+
+    while (TEC_Data.RunStatus == CFE_ES_RunStatus_APP_RUN)
+    {
+        /* One consistent copy per sample, whatever the main task is loading */
+        TEC_SamplerLock();
+        Config = TEC_Data.SampleConfig;
+        TEC_SamplerUnlock();
+
+        if (Config.Mode == TEC_SAMPLE_MODE_TIME_ALIGNED)
+        {
+            TEC_SamplerWaitAligned(&Config, &Sample);
+
+            /* A switch to free running starts its periods from here */
+            CFE_PSP_GetTime(&Deadline);
+        }
+        else
+        {
+            TEC_SamplerWaitFreeRun(&Config, &Deadline, &Sample);
+        }
+
+        TEC_PERF_ENTRY(TEC_SAMPLE_TASK_PERF_ID);
+
+        Sample.Raw = TEC_Core_ReadRawSensor();
+
+        /* A full ring drops this sample and counts it in SampleRing.Overruns */
+        TEC_Core_RingPush(&TEC_Data.SampleRing, &Sample);
+
+        TEC_SamplerPublish(&Config, &Sample);
+
+        TEC_PERF_EXIT(TEC_SAMPLE_TASK_PERF_ID);
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Take every queued sample into the vote, keeping the newest one  */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+uint32 TEC_SamplerDrain(void)
+{
+    TEC_Core_Sample_t Sample;
+    uint32            Count = 0;
+    uint32            Skew;
+
+    while (TEC_Core_RingPop(&TEC_Data.SampleRing, &Sample))
+    {
+        TEC_Data.SampleRaw             = Sample.Raw;
+        TEC_Data.SampleTime.Seconds    = Sample.Seconds;
+        TEC_Data.SampleTime.Subseconds = Sample.Subseconds;
+        ++Count;
+
+        TEC_Data.DiagTlm.Payload.SampleSkewUsec = Sample.SkewUsec;
+        Skew = (Sample.SkewUsec < 0) ? (uint32)(-(int64)Sample.SkewUsec) : (uint32)Sample.SkewUsec;
+        if (Skew > TEC_Data.DiagTlm.Payload.SampleSkewMaxUsec)
+        {
+            TEC_Data.DiagTlm.Payload.SampleSkewMaxUsec = Skew;
+        }
+
+        /* Every sample is the local vote for its epoch */
+        TEC_VoterLocal(Sample.Epoch, Sample.Raw);
+    }
+
+    TEC_Data.DiagTlm.Payload.SamplesConsumed += Count;
+
+    return Count;
+}
@@ -0,0 +1,225 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the TEC App self-benchmark.
+ *
+ * The conversion kernel and the voting strategy of the active configuration
+ * are timed on synthetic inputs, a slice at a time, between the messages the
+ * runloop handles. The vote takes one value per configured voter. The result
+ * goes out once in a TEC_SelfBenchTlm_t packet.
+ */
+
+/*
+** Include Files:
+*/
+#include "cfe_psp.h"
+
+#include "tec.h"
+#include "tec_selfbench.h"
+#include "tec_eventids.h"
+#include "tec_msgids.h"
+
+#include "tec_core.h"
+
+#define TEC_SELF_BENCH_VOTE_SETS 4
+
+/*
+** Synthetic vote inputs, built for the configured voters when a run is
+** armed: unanimous, local outvoted, all different, last remote off
+*/
+static TEC_Core_VoteInput_t TEC_SelfBenchVoteInputs[TEC_SELF_BENCH_VOTE_SETS];
+
+/* Strategy of the configuration the run was armed with */
+static TEC_Core_VoteFunc_t TEC_SelfBenchVoteFunc;
+
+/* Keeps the compiler from dropping the kernel calls */
+static volatile uint32 TEC_SelfBenchSink;
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Fold one timed chunk into a kernel's statistics                 */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void TEC_SelfBenchAccumulate(TEC_KernelTiming_t *Timing, uint64 *TotalNsec, OS_time_t Start, OS_time_t End,
+                                    uint32 ChunkOps)
+{
+    int64  ChunkNsec = OS_TimeGetTotalNanoseconds(OS_TimeSubtract(End, Start));
+    uint32 PerOp;
+
+    if (ChunkNsec < 0)
+    {
+        ChunkNsec = 0;
+    }
+
+    PerOp = (uint32)(ChunkNsec / ChunkOps);
+
+    if (Timing->Operations == 0 || PerOp < Timing->MinNsec)
+    {
+        Timing->MinNsec = PerOp;
+    }
+    if (PerOp > Timing->MaxNsec)
+    {
+        Timing->MaxNsec = PerOp;
+    }
+
+    *TotalNsec += (uint64)ChunkNsec;
+    Timing->Operations += ChunkOps;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Initialize the self-benchmark result packet                     */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_SelfBenchInit(void)
+{
+    CFE_MSG_Init(CFE_MSG_PTR(TEC_Data.SelfBenchTlm.TelemetryHeader), CFE_SB_ValueToMsgId(TEC_SELF_BENCH_TLM_MID),
+                 sizeof(TEC_Data.SelfBenchTlm));
+
+    TEC_Data.SelfBenchRemaining = 0;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Arm a new benchmark run                                         */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_SelfBenchStart(uint32 Iterations)
+{
+    TEC_Core_VoteInput_t *Input;
+    uint32                Voters = 1 + TEC_Data.Voter.ReplicaCount;
+    uint32                Set;
+    uint32                i;
+
+    memset(&TEC_Data.SelfBenchTlm.Payload, 0, sizeof(TEC_Data.SelfBenchTlm.Payload));
+    memset(TEC_SelfBenchVoteInputs, 0, sizeof(TEC_SelfBenchVoteInputs));
+
+    for (Set = 0; Set < TEC_SELF_BENCH_VOTE_SETS; ++Set)
+    {
+        Input              = &TEC_SelfBenchVoteInputs[Set];
+        Input->Count       = Voters;
+        Input->HealthyMask = (uint32)(((uint64)1 << Voters) - 1);
+        Input->Tolerance   = TEC_Data.Voter.Config.Tolerance;
+
+        for (i = 0; i < Voters; ++i)
+        {
+            Input->Values[i]  = 55;
+            Input->Weights[i] = TEC_Data.Voter.Config.Weight[i];
+        }
+    }
+
+    TEC_SelfBenchVoteInputs[1].Values[0] = 56;
+    for (i = 0; i < Voters; ++i)
+    {
+        TEC_SelfBenchVoteInputs[2].Values[i] = 55 + i;
+    }
+    TEC_SelfBenchVoteInputs[3].Values[Voters - 1] = 56;
+
+    TEC_SelfBenchVoteFunc                  = TEC_Data.Voter.VoteFunc;
+    TEC_Data.SelfBenchTlm.Payload.VoteMode = TEC_Data.Voter.Config.Mode;
+    TEC_Data.SelfBenchTlm.Payload.Voters   = Voters;
+
+    TEC_Data.SelfBenchConvertNsec = 0;
+    TEC_Data.SelfBenchVoteNsec    = 0;
+    TEC_Data.SelfBenchRemaining   = Iterations;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Run one slice of a pending benchmark, report when it completes  */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_SelfBenchRunSlice(void)
+{
+    TEC_SelfBenchTlm_Payload_t *Result = &TEC_Data.SelfBenchTlm.Payload;
+    uint32                      SliceOps;
+    uint32                      ChunkOps;
+    uint32                      Seq;
+    uint32                      i;
+    uint32                      Value;
+    uint32                      Mask;
+    OS_time_t                   Start;
+    OS_time_t                   End;
+
+    if (TEC_Data.SelfBenchRemaining == 0)
+    {
+        return;
+    }
+
+    TEC_PERF_ENTRY(TEC_SELF_BENCH_PERF_ID);
+
+    SliceOps = TEC_Data.SelfBenchRemaining;
+    if (SliceOps > TEC_SELF_BENCH_SLICE_OPS)
+    {
+        SliceOps = TEC_SELF_BENCH_SLICE_OPS;
+    }
+
+    while (SliceOps > 0)
+    {
+        ChunkOps = SliceOps;
+        if (ChunkOps > TEC_SELF_BENCH_CHUNK_OPS)
+        {
+            ChunkOps = TEC_SELF_BENCH_CHUNK_OPS;
+        }
+
+        Seq = Result->Convert.Operations;
+        CFE_PSP_GetTime(&Start);
+        for (i = 0; i < ChunkOps; ++i)
+        {
+            TEC_Core_ConvertTemperature((Seq + i) & 0xFF, ((Seq + i) & 1) ? 'F' : 'C', &Value);
+            TEC_SelfBenchSink = Value;
+        }
+        CFE_PSP_GetTime(&End);
+        TEC_SelfBenchAccumulate(&Result->Convert, &TEC_Data.SelfBenchConvertNsec, Start, End, ChunkOps);
+
+        Seq = Result->Vote.Operations;
+        CFE_PSP_GetTime(&Start);
+        for (i = 0; i < ChunkOps; ++i)
+        {
+            TEC_SelfBenchSink =
+                TEC_SelfBenchVoteFunc(&TEC_SelfBenchVoteInputs[(Seq + i) % TEC_SELF_BENCH_VOTE_SETS], &Value, &Mask);
+        }
+        CFE_PSP_GetTime(&End);
+        TEC_SelfBenchAccumulate(&Result->Vote, &TEC_Data.SelfBenchVoteNsec, Start, End, ChunkOps);
+
+        SliceOps -= ChunkOps;
+        TEC_Data.SelfBenchRemaining -= ChunkOps;
+    }
+
+    ++Result->Slices;
+
+    if (TEC_Data.SelfBenchRemaining == 0)
+    {
+        Result->Convert.MeanNsec = (uint32)(TEC_Data.SelfBenchConvertNsec / Result->Convert.Operations);
+        Result->Vote.MeanNsec    = (uint32)(TEC_Data.SelfBenchVoteNsec / Result->Vote.Operations);
+
+        CFE_SB_TimeStampMsg(CFE_MSG_PTR(TEC_Data.SelfBenchTlm.TelemetryHeader));
+        CFE_SB_TransmitMsg(CFE_MSG_PTR(TEC_Data.SelfBenchTlm.TelemetryHeader), true);
+
+        CFE_EVS_SendEvent(TEC_SELF_BENCH_INF_EID, CFE_EVS_EventType_INFORMATION,
+                          "TEC: Self-benchmark done, convert %lu/%lu/%lu ns, vote mode %lu of %lu %lu/%lu/%lu ns",
+                          (unsigned long)Result->Convert.MinNsec, (unsigned long)Result->Convert.MeanNsec,
+                          (unsigned long)Result->Convert.MaxNsec, (unsigned long)Result->VoteMode,
+                          (unsigned long)Result->Voters, (unsigned long)Result->Vote.MinNsec,
+                          (unsigned long)Result->Vote.MeanNsec, (unsigned long)Result->Vote.MaxNsec);
+    }
+
+    TEC_PERF_EXIT(TEC_SELF_BENCH_PERF_ID);
+}
@@ -0,0 +1,200 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the TEC App replica state transfer
+ *
+ *   A node that starts up knows nothing of the vote: it would report no
+ *   voted value and treat every replica as healthy until its own votes and
+ *   health windows caught up. Instead it asks the other replicas once, and
+ *   the first healthy one to answer hands over the newest voted value, its
+ *   epoch and the voter states. Replicas are named by their exchange
+ *   message ID, so voter masks can be carried between nodes whose voter
+ *   order differs.
+ */
+
+/*
+** Include Files:
+*/
+#include "tec.h"
+#include "tec_capture.h"
+#include "tec_eventids.h"
+#include "tec_msgids.h"
+#include "tec_replica.h"
+#include "tec_state.h"
+
+#include "tec_core_epoch.h"
+#include "tec_core_health.h"
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Local voter index of a node named by its exchange message ID    */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static bool TEC_StateVoter(uint32 MsgId, uint32 *Voter)
+{
+    uint8 ReplicaIndex;
+
+    if (MsgId == TEC_Data.Config.LocalExchangeMsgId)
+    {
+        *Voter = 0;
+        return true;
+    }
+
+    if (TEC_ReplicaLookup(CFE_SB_ValueToMsgId(MsgId), &ReplicaIndex))
+    {
+        *Voter = 1 + ReplicaIndex;
+        return true;
+    }
+
+    return false;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Ask the other replicas for the vote state                       */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_StateRequest(void)
+{
+    TEC_StateRequestTlm_t Request;
+
+    if (TEC_Data.Voter.ReplicaCount == 0)
+    {
+        return;
+    }
+
+    CFE_MSG_Init(CFE_MSG_PTR(Request.TelemetryHeader), CFE_SB_ValueToMsgId(TEC_STATE_REQ_MID), sizeof(Request));
+    Request.Payload.Requester = TEC_Data.Config.LocalExchangeMsgId;
+
+    TEC_Data.StatePending = true;
+
+    CFE_SB_TimeStampMsg(CFE_MSG_PTR(Request.TelemetryHeader));
+    CFE_SB_TransmitMsg(CFE_MSG_PTR(Request.TelemetryHeader), true);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Answer a replica that asks for the vote state                   */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_StateRequestReceived(const TEC_StateRequestTlm_t *Msg)
+{
+    TEC_StateResponseTlm_t Response;
+    uint32                 Voter;
+    uint32                 i;
+
+    /*
+    ** Only a member of the vote is answered, and only by a node that has
+    ** voted and whose own value is still trusted
+    */
+    if (!TEC_StateVoter(Msg->Payload.Requester, &Voter) || Voter == 0 || !TEC_Data.Voter.VoteValid ||
+        (TEC_Data.Voter.Health.Active & 1U) == 0)
+    {
+        return;
+    }
+
+    CFE_MSG_Init(CFE_MSG_PTR(Response.TelemetryHeader), CFE_SB_ValueToMsgId(TEC_STATE_RSP_MID), sizeof(Response));
+    memset(&Response.Payload, 0, sizeof(Response.Payload));
+
+    Response.Payload.Responder     = TEC_Data.Config.LocalExchangeMsgId;
+    Response.Payload.Requester     = Msg->Payload.Requester;
+    Response.Payload.Epoch         = TEC_Data.Voter.VotedEpoch;
+    Response.Payload.Temperature   = TEC_Data.Voter.Temperature;
+    Response.Payload.Unit          = TEC_Data.Voter.Unit;
+    Response.Payload.VoterCount    = (uint8)(1 + TEC_Data.Voter.ReplicaCount);
+    Response.Payload.AgreeMask     = TEC_Data.Voter.AgreeMask;
+    Response.Payload.ActiveMask    = TEC_Data.Voter.Health.Active;
+    Response.Payload.ProbationMask = TEC_Data.Voter.Health.Probation;
+
+    Response.Payload.VoterMsgId[0] = TEC_Data.Config.LocalExchangeMsgId;
+    for (i = 0; i < TEC_Data.Voter.ReplicaCount; i++)
+    {
+        Response.Payload.VoterMsgId[1 + i] = TEC_Data.Voter.ReplicaId[i];
+    }
+
+    CFE_SB_TimeStampMsg(CFE_MSG_PTR(Response.TelemetryHeader));
+    CFE_SB_TransmitMsg(CFE_MSG_PTR(Response.TelemetryHeader), true);
+
+    CFE_EVS_SendEvent(TEC_STATE_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "TEC App: Sent the vote state of epoch %lu to replica 0x%04lx",
+                      (unsigned long)TEC_Data.Voter.VotedEpoch, (unsigned long)Msg->Payload.Requester);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Join the vote from the state a replica sent                     */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_StateResponseReceived(const TEC_StateResponseTlm_t *Msg)
+{
+    const TEC_StateResponse_Payload_t *Payload = &Msg->Payload;
+    uint32                             Count;
+    uint32                             Voter;
+    uint32                             Known     = 0;
+    uint32                             Active    = 0;
+    uint32                             Probation = 0;
+    uint32                             Agree     = 0;
+    uint32                             i;
+
+    /* The first answer wins; others, and answers to other nodes, are ignored */
+    if (!TEC_Data.StatePending || Payload->Requester != TEC_Data.Config.LocalExchangeMsgId ||
+        !TEC_StateVoter(Payload->Responder, &Voter) || Voter == 0)
+    {
+        return;
+    }
+
+    TEC_Data.StatePending = false;
+
+    /* The responder saw this node go silent; its own voter starts afresh */
+    Count = (Payload->VoterCount < TEC_MAX_VOTERS) ? Payload->VoterCount : TEC_MAX_VOTERS;
+    for (i = 0; i < Count; i++)
+    {
+        if (TEC_StateVoter(Payload->VoterMsgId[i], &Voter) && Voter != 0)
+        {
+            Known |= 1U << Voter;
+            Active |= ((Payload->ActiveMask >> i) & 1U) << Voter;
+            Probation |= ((Payload->ProbationMask >> i) & 1U) << Voter;
+            Agree |= ((Payload->AgreeMask >> i) & 1U) << Voter;
+        }
+    }
+
+    TEC_Core_HealthRestore(&TEC_Data.Voter.Health, Known, Active, Probation);
+    TEC_Core_EpochResume(&TEC_Data.Voter.Epochs, Payload->Epoch);
+
+    /*
+    ** A value in another unit is not taken, nor one older than the vote
+    ** restored from the CDS; the next vote here fills it in
+    */
+    if (Payload->Unit == TEC_Data.Voter.Unit &&
+        (!TEC_Data.Voter.VoteValid || (int32)(Payload->Epoch - TEC_Data.Voter.VotedEpoch) > 0))
+    {
+        TEC_Data.Voter.Temperature = Payload->Temperature;
+        TEC_Data.Voter.AgreeMask   = Agree;
+        TEC_Data.Voter.VotedEpoch  = Payload->Epoch;
+        TEC_Data.Voter.VoteValid   = true;
+    }
+
+    TEC_CaptureVoter();
+
+    CFE_EVS_SendEvent(TEC_STATE_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "TEC App: Joined the vote at epoch %lu from replica 0x%04lx, active voters 0x%08lx",
+                      (unsigned long)Payload->Epoch, (unsigned long)Payload->Responder,
+                      (unsigned long)TEC_Data.Voter.Health.Active);
+}
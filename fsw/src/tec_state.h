@@ -0,0 +1,36 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *   This file contains the prototypes for the TEC App replica state transfer
+ */
+
+#ifndef TEC_STATE_H
+#define TEC_STATE_H
+
+/*
+** Required header files.
+*/
+#include "tec.h"
+
+void TEC_StateRequest(void);
+void TEC_StateRequestReceived(const TEC_StateRequestTlm_t *Msg);
+void TEC_StateResponseReceived(const TEC_StateResponseTlm_t *Msg);
+
+#endif /* TEC_STATE_H */
@@ -0,0 +1,264 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the TEC App UDP replica transport
+ *
+ *   When the configuration table selects it, the sampling task sends its
+ *   exchange packets straight to every peer over one UDP socket, a few to
+ *   a datagram, instead of publishing them on the software bus and leaving
+ *   the hop to the other nodes to a bridge. OSAL has no multicast group
+ *   membership, so each datagram is sent once per peer. The main task
+ *   takes the packets back out of the datagrams and passes those from a
+ *   configured replica straight to the replica handler; anything else on
+ *   the socket is only counted.
+ *
+ *   The main task sets the transport up and tears it down while the
+ *   sampling task may be sending, so the transmit state is only touched
+ *   under the sampler lock.
+ */
+
+/*
+** Include Files:
+*/
+#include "tec.h"
+#include "tec_eventids.h"
+#include "tec_sampler.h"
+#include "tec_udp.h"
+
+/* A batch must reach the voter before its oldest sample misses the vote deadline */
+CompileTimeAssert(TEC_UDP_BATCH_MAX <= TEC_VOTE_DEADLINE_EPOCHS, TecUdpBatchWithinVoteDeadline);
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Start out with no socket                                        */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_UdpInit(void)
+{
+    TEC_Data.UdpSocketId = OS_OBJECT_ID_UNDEFINED;
+    TEC_Data.UdpActive   = false;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Whether an endpoint from the configuration table is usable      */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool TEC_UdpEndpointValid(const TEC_UdpEndpoint_t *Endpoint)
+{
+    return memchr(Endpoint->Address, 0, sizeof(Endpoint->Address)) != NULL && Endpoint->Port > 0 &&
+           Endpoint->Port <= 0xFFFF;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Socket address of an endpoint                                   */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static int32 TEC_UdpAddress(const TEC_UdpEndpoint_t *Endpoint, OS_SockAddr_t *Addr)
+{
+    int32 OsStatus;
+
+    OsStatus = OS_SocketAddrInit(Addr, OS_SocketDomain_INET);
+    if (OsStatus == OS_SUCCESS)
+    {
+        OsStatus = OS_SocketAddrFromString(Addr, Endpoint->Address);
+    }
+    if (OsStatus == OS_SUCCESS)
+    {
+        OsStatus = OS_SocketAddrSetPort(Addr, (uint16)Endpoint->Port);
+    }
+
+    return OsStatus;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Open the socket the configuration table asks for, if any        */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+CFE_Status_t TEC_UdpConfigure(void)
+{
+    OS_SockAddr_t LocalAddr;
+    OS_SockAddr_t PeerAddr[TEC_MAX_REPLICAS];
+    osal_id_t     SocketId = OS_OBJECT_ID_UNDEFINED;
+    int32         OsStatus;
+    uint32        i;
+
+    TEC_UdpClose();
+
+    if (TEC_Data.Config.Transport != TEC_TRANSPORT_UDP)
+    {
+        return CFE_SUCCESS;
+    }
+
+    /* The table validation function has already checked every endpoint */
+    OsStatus = TEC_UdpAddress(&TEC_Data.Config.UdpLocal, &LocalAddr);
+    for (i = 0; i < TEC_Data.Voter.ReplicaCount && OsStatus == OS_SUCCESS; i++)
+    {
+        OsStatus = TEC_UdpAddress(&TEC_Data.Config.UdpPeer[i], &PeerAddr[i]);
+    }
+    if (OsStatus == OS_SUCCESS)
+    {
+        OsStatus = OS_SocketOpen(&SocketId, OS_SocketDomain_INET, OS_SocketType_DATAGRAM);
+    }
+    if (OsStatus == OS_SUCCESS)
+    {
+        OsStatus = OS_SocketBind(SocketId, &LocalAddr);
+    }
+
+    /* The software bus still works, so a transport that cannot be set up is not fatal */
+    if (OsStatus != OS_SUCCESS)
+    {
+        CFE_EVS_SendEvent(TEC_UDP_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "TEC App: Error setting up UDP on %s:%lu, exchanging over SB, RC = %ld",
+                          TEC_Data.Config.UdpLocal.Address, (unsigned long)TEC_Data.Config.UdpLocal.Port,
+                          (long)OsStatus);
+        if (OS_ObjectIdDefined(SocketId))
+        {
+            OS_close(SocketId);
+        }
+        return CFE_SUCCESS;
+    }
+
+    /* The sampling task switches over with its next packet, into an empty datagram */
+    TEC_SamplerLock();
+    TEC_Data.UdpSocketId  = SocketId;
+    TEC_Data.UdpPeerCount = TEC_Data.Voter.ReplicaCount;
+    memcpy(TEC_Data.UdpPeerAddr, PeerAddr, TEC_Data.UdpPeerCount * sizeof(PeerAddr[0]));
+    TEC_Data.UdpBatch   = TEC_Data.Config.UdpBatch;
+    TEC_Data.UdpTxCount = 0;
+    TEC_Data.UdpActive  = true;
+    TEC_SamplerUnlock();
+
+    CFE_EVS_SendEvent(TEC_UDP_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "TEC App: Exchanging over UDP on %s:%lu with %lu peer(s), %lu packet(s) per datagram",
+                      TEC_Data.Config.UdpLocal.Address, (unsigned long)TEC_Data.Config.UdpLocal.Port,
+                      (unsigned long)TEC_Data.UdpPeerCount, (unsigned long)TEC_Data.UdpBatch);
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Close the socket, exchange packets go back to the software bus  */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void TEC_UdpClose(void)
+{
+    osal_id_t SocketId;
+
+    /* A partly filled datagram is dropped; its samples show up as a gap */
+    TEC_SamplerLock();
+    SocketId             = TEC_Data.UdpSocketId;
+    TEC_Data.UdpSocketId = OS_OBJECT_ID_UNDEFINED;
+    TEC_Data.UdpActive   = false;
+    TEC_Data.UdpTxCount  = 0;
+    TEC_SamplerUnlock();
+
+    /* Packets already taken off the old socket are not handed out */
+    TEC_Data.UdpRxCount = 0;
+    TEC_Data.UdpRxNext  = 0;
+
+    if (OS_ObjectIdDefined(SocketId))
+    {
+        OS_close(SocketId);
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Queue an exchange packet, send the datagram once it is full;    */
+/* false if UDP is not active (sampling task only)                 */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool TEC_UdpSend(const TEC_ExchangeTlm_t *Msg)
+{
+    bool   Active;
+    uint32 i;
+
+    TEC_SamplerLock();
+
+    Active = TEC_Data.UdpActive;
+    if (Active)
+    {
+        TEC_Data.UdpTx[TEC_Data.UdpTxCount++] = *Msg;
+
+        /*
+        ** Best effort like the software bus: a datagram that does not arrive
+        ** shows up as a sequence gap in the receiver's link statistics
+        */
+        if (TEC_Data.UdpTxCount >= TEC_Data.UdpBatch || TEC_Data.UdpTxCount >= TEC_UDP_BATCH_MAX)
+        {
+            for (i = 0; i < TEC_Data.UdpPeerCount; i++)
+            {
+                OS_SocketSendTo(TEC_Data.UdpSocketId, TEC_Data.UdpTx,
+                                TEC_Data.UdpTxCount * sizeof(TEC_Data.UdpTx[0]), &TEC_Data.UdpPeerAddr[i]);
+            }
+
+            TEC_Data.UdpTxCount = 0;
+        }
+    }
+
+    TEC_SamplerUnlock();
+
+    return Active;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Next exchange packet received over UDP, if any                  */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+bool TEC_UdpReceive(CFE_SB_Buffer_t **SBBufPtr)
+{
+    OS_SockAddr_t FromAddr;
+    int32         Length;
+
+    while (TEC_Data.UdpRxNext >= TEC_Data.UdpRxCount)
+    {
+        if (!TEC_Data.UdpActive)
+        {
+            return false;
+        }
+
+        Length = OS_SocketRecvFrom(TEC_Data.UdpSocketId, TEC_Data.UdpRx, sizeof(TEC_Data.UdpRx), &FromAddr, OS_CHECK);
+        if (Length <= 0)
+        {
+            return false;
+        }
+
+        ++TEC_Data.DiagTlm.Payload.UdpDatagrams;
+
+        /* The sender is identified by the message ID in each packet, as on the software bus */
+        if ((uint32)Length % sizeof(TEC_Data.UdpRx[0]) != 0)
+        {
+            ++TEC_Data.DiagTlm.Payload.UdpRejected;
+            continue;
+        }
+
+        TEC_Data.UdpRxCount = (uint32)Length / sizeof(TEC_Data.UdpRx[0]);
+        TEC_Data.UdpRxNext  = 0;
+    }
+
+    *SBBufPtr = (CFE_SB_Buffer_t *)&TEC_Data.UdpRx[TEC_Data.UdpRxNext++];
+
+    return true;
+}
@@ -28,6 +28,10 @@
 #include "tec_eventids.h"
 #include "tec_tbl.h"
 #include "tec_utils.h"
+#include "tec_replica.h"
+#include "tec_sampler.h"
+#include "tec_udp.h"
+#include "tec_voter.h"
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 /*                                                                 */
@@ -51,6 +55,155 @@ CFE_Status_t TEC_TblValidationFunc(void *TblData)
     return ReturnCode;
 }
 
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Whether a message ID is one the app subscribes to for itself    */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static bool TEC_MsgIdReserved(CFE_SB_MsgId_Atom_t MsgId)
+{
+    return MsgId == TEC_CMD_MID || MsgId == TEC_SEND_HK_MID || MsgId == TEC_WAKEUP_MID ||
+           MsgId == TEC_STATE_REQ_MID || MsgId == TEC_STATE_RSP_MID;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Verify contents of the Configuration Table buffer               */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+CFE_Status_t TEC_ConfigTblValidationFunc(void *TblData)
+{
+    CFE_Status_t       ReturnCode = CFE_SUCCESS;
+    TEC_ConfigTable_t *TblDataPtr = (TEC_ConfigTable_t *)TblData;
+    TEC_Core_IdMap_t   Seen;
+    uint32             WeightSum = 0;
+    uint32             i;
+
+    if (TblDataPtr->SamplePeriodMsec < TEC_SAMPLE_PERIOD_MIN_MSEC ||
+        TblDataPtr->SamplePeriodMsec > TEC_SAMPLE_PERIOD_MAX_MSEC)
+    {
+        ReturnCode = TEC_TABLE_OUT_OF_RANGE_ERR_CODE;
+    }
+    else if (TblDataPtr->SampleMode >= TEC_SAMPLE_MODE_COUNT ||
+             TblDataPtr->SamplePhaseMsec >= TblDataPtr->SamplePeriodMsec)
+    {
+        ReturnCode = TEC_TABLE_OUT_OF_RANGE_ERR_CODE;
+    }
+    else if (TEC_Core_VoteStrategy(TblDataPtr->VoteMode) == NULL)
+    {
+        ReturnCode = TEC_TABLE_OUT_OF_RANGE_ERR_CODE;
+    }
+    else if (TblDataPtr->ReplicaCount > TEC_MAX_REPLICAS)
+    {
+        ReturnCode = TEC_TABLE_OUT_OF_RANGE_ERR_CODE;
+    }
+    else if (TblDataPtr->Transport >= TEC_TRANSPORT_COUNT || TblDataPtr->UdpBatch < 1 ||
+             TblDataPtr->UdpBatch > TEC_UDP_BATCH_MAX)
+    {
+        ReturnCode = TEC_TABLE_OUT_OF_RANGE_ERR_CODE;
+    }
+    else
+    {
+        /*
+        ** Every exchange message ID, this node's and the replicas', must be
+        ** valid, listed once and not one the dispatcher routes elsewhere,
+        ** or the node it belongs to is never heard
+        */
+        TEC_Core_IdMapInit(&Seen);
+        if (!CFE_SB_IsValidMsgId(CFE_SB_ValueToMsgId(TblDataPtr->LocalExchangeMsgId)) ||
+            TEC_MsgIdReserved(TblDataPtr->LocalExchangeMsgId) ||
+            !TEC_Core_IdMapInsert(&Seen, TblDataPtr->LocalExchangeMsgId, TEC_MAX_REPLICAS))
+        {
+            ReturnCode = TEC_TABLE_OUT_OF_RANGE_ERR_CODE;
+        }
+        for (i = 0; i < TblDataPtr->ReplicaCount && ReturnCode == CFE_SUCCESS; i++)
+        {
+            if (!CFE_SB_IsValidMsgId(CFE_SB_ValueToMsgId(TblDataPtr->ReplicaMsgId[i])) ||
+                TEC_MsgIdReserved(TblDataPtr->ReplicaMsgId[i]) ||
+                !TEC_Core_IdMapInsert(&Seen, TblDataPtr->ReplicaMsgId[i], (uint8)i))
+            {
+                ReturnCode = TEC_TABLE_OUT_OF_RANGE_ERR_CODE;
+                break;
+            }
+        }
+
+        /* Endpoints only matter when UDP is selected */
+        if (TblDataPtr->Transport == TEC_TRANSPORT_UDP && ReturnCode == CFE_SUCCESS)
+        {
+            if (!TEC_UdpEndpointValid(&TblDataPtr->UdpLocal))
+            {
+                ReturnCode = TEC_TABLE_OUT_OF_RANGE_ERR_CODE;
+            }
+            for (i = 0; i < TblDataPtr->ReplicaCount && ReturnCode == CFE_SUCCESS; i++)
+            {
+                if (!TEC_UdpEndpointValid(&TblDataPtr->UdpPeer[i]))
+                {
+                    ReturnCode = TEC_TABLE_OUT_OF_RANGE_ERR_CODE;
+                }
+            }
+        }
+
+        /* Weights are 16 bit so the weighted sum cannot overflow */
+        for (i = 0; i < TEC_MAX_VOTERS && ReturnCode == CFE_SUCCESS; i++)
+        {
+            if (TblDataPtr->VoteWeight[i] > TEC_VOTE_WEIGHT_MAX)
+            {
+                ReturnCode = TEC_TABLE_OUT_OF_RANGE_ERR_CODE;
+            }
+        }
+
+        /* A weighted average over voters that all weigh nothing never has a result */
+        for (i = 0; i <= TblDataPtr->ReplicaCount && ReturnCode == CFE_SUCCESS; i++)
+        {
+            WeightSum += TblDataPtr->VoteWeight[i];
+        }
+        if (TblDataPtr->VoteMode == TEC_VOTE_MODE_WEIGHTED_AVERAGE && WeightSum == 0)
+        {
+            ReturnCode = TEC_TABLE_OUT_OF_RANGE_ERR_CODE;
+        }
+    }
+
+    return ReturnCode;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Copy the Configuration Table into the active configuration      */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+CFE_Status_t TEC_LoadConfigTable(void)
+{
+    CFE_Status_t       status;
+    TEC_ConfigTable_t *TblPtr;
+
+    status = CFE_TBL_GetAddress((void **)&TblPtr, TEC_Data.TblHandles[TEC_CONFIG_TBL_IDX]);
+    if (status == CFE_SUCCESS || status == CFE_TBL_INFO_UPDATED)
+    {
+        TEC_Data.Config = *TblPtr;
+        CFE_TBL_ReleaseAddress(TEC_Data.TblHandles[TEC_CONFIG_TBL_IDX]);
+
+        /* The sampling task only ever sees this published copy */
+        TEC_SamplerConfigure();
+
+        CFE_EVS_SendEvent(TEC_CONFIG_INF_EID, CFE_EVS_EventType_INFORMATION,
+                          "TEC App: Configuration loaded, sample period %lu ms, vote mode %lu, tolerance %lu",
+                          (unsigned long)TEC_Data.Config.SamplePeriodMsec, (unsigned long)TEC_Data.Config.VoteMode,
+                          (unsigned long)TEC_Data.Config.VoteTolerance);
+
+        status = TEC_VoterConfigure();
+        if (status == CFE_SUCCESS)
+        {
+            status = TEC_ReplicaConfigure();
+        }
+        if (status == CFE_SUCCESS)
+        {
+            status = TEC_UdpConfigure();
+        }
+    }
+
+    return status;
+}
+
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 /*                                                                 */
 /* Output CRC                                                      */
@@ -30,6 +30,8 @@
 #include "tec.h"
 
 CFE_Status_t TEC_TblValidationFunc(void *TblData);
+CFE_Status_t TEC_ConfigTblValidationFunc(void *TblData);
+CFE_Status_t TEC_LoadConfigTable(void);
 void         TEC_GetCrc(const char *TableName);
 
 #endif /* TEC_UTILS_H */
\ No newline at end of file
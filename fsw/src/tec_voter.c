@@ -0,0 +1,243 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the TEC App majority voting.
+ */
+
+/*
+** Include Files:
+*/
+#include "tec.h"
+#include "tec_voter.h"
+#include "tec_hwcount.h"
+#include "tec_capture.h"
+#include "tec_eventids.h"
+
+#include "cfe_psp.h"
+
+#include "tec_core.h"
+#include "tec_core_median.h"
+
+/* The local value plus every remote replica must fit the vote state and the median and fusion kernels */
+CompileTimeAssert(TEC_MAX_VOTERS == 1 + TEC_MAX_REPLICAS, TecVotersAreLocalPlusReplicas);
+CompileTimeAssert(TEC_MAX_VOTERS <= TEC_CORE_VOTER_MAX, TecVotersFitVoteState);
+CompileTimeAssert(TEC_MAX_VOTERS <= TEC_CORE_SORT_MAX, TecVotersFitMedianKernels);
+CompileTimeAssert(TEC_VOTE_DEADLINE_EPOCHS < TEC_CORE_EPOCH_SLOTS, TecVoteDeadlineFitsEpochSlots);
+
+/* The table vote modes and exchange quality flags are the ones of the core library */
+CompileTimeAssert(TEC_VOTE_MODE_MAJORITY == TEC_CORE_VOTE_MODE_MAJORITY, TecVoteModeMajority);
+CompileTimeAssert(TEC_VOTE_MODE_MID_VALUE == TEC_CORE_VOTE_MODE_MID_VALUE, TecVoteModeMidValue);
+CompileTimeAssert(TEC_VOTE_MODE_MEDIAN == TEC_CORE_VOTE_MODE_MEDIAN, TecVoteModeMedian);
+CompileTimeAssert(TEC_VOTE_MODE_TOLERANCE_MAJORITY == TEC_CORE_VOTE_MODE_TOLERANCE_MAJORITY,
+                  TecVoteModeToleranceMajority);
+CompileTimeAssert(TEC_VOTE_MODE_WEIGHTED_AVERAGE == TEC_CORE_VOTE_MODE_WEIGHTED_AVERAGE, TecVoteModeWeightedAverage);
+CompileTimeAssert(TEC_VOTE_MODE_FIRST_HEALTHY == TEC_CORE_VOTE_MODE_FIRST_HEALTHY, TecVoteModeFirstHealthy);
+CompileTimeAssert(TEC_VOTE_MODE_COUNT == TEC_CORE_VOTE_MODE_COUNT, TecVoteModeCount);
+CompileTimeAssert(TEC_EXCHANGE_QUALITY_VALID == TEC_CORE_QUALITY_VALID, TecExchangeQualityValid);
+CompileTimeAssert(sizeof(TEC_Exchange_Payload_t) == sizeof(TEC_Core_ExchangeSample_t), TecExchangeSampleLayout);
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Take over the vote parameters of the active configuration, once per load  */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+CFE_Status_t TEC_VoterConfigure(void)
+{
+    TEC_Core_VoterConfig_t VoterConfig;
+    uint32                 i;
+
+    memset(&VoterConfig, 0, sizeof(VoterConfig));
+    VoterConfig.Mode           = TEC_Data.Config.VoteMode;
+    VoterConfig.Tolerance      = TEC_Data.Config.VoteTolerance;
+    VoterConfig.MinVoters      = TEC_VOTE_MIN_VOTERS;
+    VoterConfig.DeadlineEpochs = TEC_VOTE_DEADLINE_EPOCHS;
+    VoterConfig.HealthWindow   = TEC_HEALTH_WINDOW_EPOCHS;
+    for (i = 0; i < TEC_MAX_VOTERS; i++)
+    {
+        VoterConfig.Weight[i] = TEC_Data.Config.VoteWeight[i];
+    }
+
+    /* The table validation function has already rejected unknown modes */
+    if (!TEC_Core_VoterConfigure(&TEC_Data.Voter, &VoterConfig))
+    {
+        return TEC_TABLE_OUT_OF_RANGE_ERR_CODE;
+    }
+
+    TEC_CaptureVoter();
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Convert every value to a new unit from now on                              */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void TEC_VoterSetUnit(char Unit)
+{
+    TEC_Data.Voter.Unit = Unit;
+
+    TEC_CaptureVoter();
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* File a local sample under its sample epoch                                 */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void TEC_VoterLocal(uint32 Epoch, uint32 Raw)
+{
+    TEC_CaptureSample(Epoch, Raw);
+
+    TEC_Core_VoterLocal(&TEC_Data.Voter, Epoch, Raw);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Vote on the temperatures of one sample epoch                               */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void TEC_VoteEpoch(const TEC_Core_EpochSlot_t *Slot)
+{
+    TEC_Core_VoteReport_t Report;
+    bool                  Voted;
+    bool                  WasValid    = TEC_Data.Voter.VoteValid;
+    uint32                Temperature = TEC_Data.Voter.Temperature;
+    OS_time_t             Now;
+
+    TEC_PERF_ENTRY(TEC_VOTER_PERF_ID);
+    TEC_HwCountBegin(TEC_HWCOUNT_STAGE_VOTER);
+
+    Voted = TEC_Core_VoterVote(&TEC_Data.Voter, Slot, &Report);
+
+    TEC_HwCountEnd(TEC_HWCOUNT_STAGE_VOTER);
+    TEC_PERF_EXIT(TEC_VOTER_PERF_ID);
+
+    if (!Voted)
+    {
+        return;
+    }
+
+    if (Report.Outcome == TEC_CORE_VOTE_NO_MAJORITY)
+    {
+        // TEC_Data.Temperature = -1;
+        CFE_EVS_SendEvent(TEC_MID_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "TEC: Catastrophic failure... couldnt find majority!");
+        /*
+        TODO: Handle Error case...
+        For example raise some events or alerts, or request a retransmission from the faulty node
+        */
+    }
+    else
+    {
+        /* A vote of its own supersedes any state transfer still on its way */
+        TEC_Data.StatePending = false;
+
+        if (!TEC_Data.FirstVoted)
+        {
+            CFE_PSP_GetTime(&Now);
+            TEC_Data.FirstVoted    = true;
+            TEC_Data.FirstVoteMsec = (uint32)OS_TimeGetTotalMilliseconds(OS_TimeSubtract(Now, TEC_Data.InitStart));
+
+            CFE_EVS_SendEvent(TEC_STARTUP_INF_EID, CFE_EVS_EventType_INFORMATION,
+                              "TEC App: First vote at epoch %lu, %lu ms after start", (unsigned long)Report.Epoch,
+                              (unsigned long)TEC_Data.FirstVoteMsec);
+        }
+
+        if (Report.LocalLost)
+        {
+            CFE_EVS_SendEvent(TEC_MID_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "TEC: I lost the vote! My temperature is %d, but %d won...", Report.LocalValue,
+                              TEC_Data.Voter.Temperature);
+        }
+
+        /* Every epoch is voted on, so only a new value is worth an event */
+        if (!WasValid || TEC_Data.Voter.Temperature != Temperature)
+        {
+            CFE_EVS_SendEvent(TEC_VALUE_INF_EID, CFE_EVS_EventType_INFORMATION, "TEC: The voted Temperature is %d\n",
+                              TEC_Data.Voter.Temperature);
+        }
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Report voters masked or reintegrated by a health window                    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void TEC_VoterHealthEvents(uint32 Masked, uint32 Reintegrated, uint32 Seen)
+{
+    uint32 i;
+
+    for (i = 0; i < TEC_MAX_VOTERS; i++)
+    {
+        if (Masked & (1U << i))
+        {
+            CFE_EVS_SendEvent(TEC_HEALTH_INF_EID, CFE_EVS_EventType_INFORMATION,
+                              "TEC: Voter %lu masked, %s", (unsigned long)i,
+                              (Seen & (1U << i)) ? "lost every vote" : "stale");
+        }
+        else if (Reintegrated & (1U << i))
+        {
+            CFE_EVS_SendEvent(TEC_HEALTH_INF_EID, CFE_EVS_EventType_INFORMATION,
+                              "TEC: Voter %lu reintegrated after probation", (unsigned long)i);
+        }
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* TEC Majority voting on all sample epochs that are ready                    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void TEC_MajorityVoter(void)
+{
+    CFE_TIME_SysTime_t   Now = CFE_TIME_GetTime();
+    TEC_Core_EpochSlot_t Slot;
+    uint32               NowEpoch;
+    uint32               Seen;
+    uint32               Masked;
+    uint32               Reintegrated;
+
+    NowEpoch = TEC_Core_EpochOf(Now.Seconds, Now.Subseconds, TEC_Data.Config.SamplePeriodMsec);
+
+    TEC_CaptureTick(NowEpoch);
+
+    /*
+    ** Each epoch is voted on exactly once, oldest first. Only the active
+    ** voters are waited for, so a dead or masked node never holds up a vote.
+    */
+    while (TEC_Core_VoterNext(&TEC_Data.Voter, NowEpoch, &Slot))
+    {
+        TEC_VoteEpoch(&Slot);
+    }
+
+    /*
+    ** Mask stale and losing voters, TMR to duplex to simplex, and bring
+    ** them back after probation
+    */
+    if (TEC_Core_VoterHealthUpdate(&TEC_Data.Voter, NowEpoch, &Masked, &Reintegrated, &Seen) &&
+        (Masked | Reintegrated) != 0)
+    {
+        TEC_VoterHealthEvents(Masked, Reintegrated, Seen);
+    }
+
+    // TODO: Further use ElectedTemperature as the official TO/Downlink temperature...
+}
@@ -0,0 +1,42 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+#include "cfe_tbl_filedef.h" /* Required to obtain the CFE_TBL_FILEDEF macro definition */
+#include "tec_tbl.h"
+#include "tec_msgids.h"
+
+/*
+** UDP loopback test, CPU A: see tec_config_loop_tbl.c
+*/
+TEC_ConfigTable_t ConfigTable = {
+    100,                                         /* SamplePeriodMsec */
+    TEC_SAMPLE_MODE_TIME_ALIGNED,                /* SampleMode */
+    0,                                           /* SamplePhaseMsec */
+    TEC_VOTE_MODE_MAJORITY,                      /* VoteMode */
+    0,                                           /* VoteTolerance */
+    CPUA_EXCHANGE_MID,                           /* LocalExchangeMsgId */
+    2,                                           /* ReplicaCount */
+    {TEC_EXCHANGE_TLM_MID, CPUB_EXCHANGE_MID},   /* ReplicaMsgId */
+    {1, 1, 1},                                   /* VoteWeight */
+    TEC_TRANSPORT_UDP,                           /* Transport */
+    1,                                           /* UdpBatch */
+    {"127.0.0.1", 50003},                        /* UdpLocal */
+    {{"127.0.0.1", 50000}, {"127.0.0.1", 50006}} /* UdpPeer */
+};
+
+CFE_TBL_FILEDEF(ConfigTable, TEC.ConfigTable, TEC Configuration Table, tec_config_loop_cpua.tbl)
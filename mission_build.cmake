@@ -50,3 +50,9 @@ foreach(TEC_CFGFILE ${TEC_MISSION_CONFIG_FILE_LIST})
     ${DEFAULT_SOURCE}
   )
 endforeach()
+
+# Topic IDs of the tec_loadgen test application, overridable the same way
+generate_config_includefile(
+  FILE_NAME           "tec_loadgen_topicids.h"
+  FALLBACK_FILE       "${CMAKE_CURRENT_LIST_DIR}/tools/tec_loadgen/config/default_tec_loadgen_topicids.h"
+)
@@ -0,0 +1,30 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *   TEC load generator Topic IDs
+ */
+#ifndef TEC_LOADGEN_TOPICIDS_H
+#define TEC_LOADGEN_TOPICIDS_H
+
+#define CFE_MISSION_TEC_LOADGEN_CMD_TOPICID     0x9E
+#define CFE_MISSION_TEC_LOADGEN_SEND_HK_TOPICID 0x9F
+#define CFE_MISSION_TEC_LOADGEN_HK_TLM_TOPICID  0x9F
+
+#endif
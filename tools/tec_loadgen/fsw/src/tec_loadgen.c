@@ -0,0 +1,412 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * \file
+ *   This file contains the source code for the TEC load generator test app.
+ */
+
+/*
+** Include Files:
+*/
+#include "cfe_psp.h"
+
+#include "tec_loadgen.h"
+
+#include "tec_core_epoch.h"
+
+/*
+** global data
+*/
+TEC_LoadGen_Data_t TEC_LoadGen_Data;
+
+static CFE_MSG_Message_t *TEC_LoadGen_StreamMsg[TEC_LOADGEN_STREAM_COUNT];
+
+static const char *const TEC_LoadGen_StreamName[TEC_LOADGEN_STREAM_COUNT] = {"CPUA_EXCHANGE", "CPUB_EXCHANGE",
+                                                                               "CMD", "SEND_HK"};
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *  */
+/*                                                                            */
+/* Initialization                                                             */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static CFE_Status_t TEC_LoadGen_Init(void)
+{
+    CFE_Status_t status;
+
+    memset(&TEC_LoadGen_Data, 0, sizeof(TEC_LoadGen_Data));
+
+    TEC_LoadGen_Data.RunStatus = CFE_ES_RunStatus_APP_RUN;
+
+    status = CFE_EVS_Register(NULL, 0, CFE_EVS_EventFilter_BINARY);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_ES_WriteToSysLog("TEC LoadGen: Error Registering Events, RC = 0x%08lX\n", (unsigned long)status);
+        return status;
+    }
+
+    /*
+    ** Packets sent to TEC, built once and re-sent on every tick
+    */
+    CFE_MSG_Init(CFE_MSG_PTR(TEC_LoadGen_Data.CpuAExchange.TelemetryHeader), CFE_SB_ValueToMsgId(CPUA_EXCHANGE_MID),
+                 sizeof(TEC_LoadGen_Data.CpuAExchange));
+    CFE_MSG_Init(CFE_MSG_PTR(TEC_LoadGen_Data.CpuBExchange.TelemetryHeader), CFE_SB_ValueToMsgId(CPUB_EXCHANGE_MID),
+                 sizeof(TEC_LoadGen_Data.CpuBExchange));
+    CFE_MSG_Init(CFE_MSG_PTR(TEC_LoadGen_Data.TecNoop.CommandHeader), CFE_SB_ValueToMsgId(TEC_CMD_MID),
+                 sizeof(TEC_LoadGen_Data.TecNoop));
+    CFE_MSG_SetFcnCode(CFE_MSG_PTR(TEC_LoadGen_Data.TecNoop.CommandHeader), TEC_NOOP_CC);
+    CFE_MSG_Init(CFE_MSG_PTR(TEC_LoadGen_Data.TecSendHk.CommandHeader), CFE_SB_ValueToMsgId(TEC_SEND_HK_MID),
+                 sizeof(TEC_LoadGen_Data.TecSendHk));
+
+    TEC_LoadGen_StreamMsg[TEC_LOADGEN_STREAM_CPUA_EXCHANGE] =
+        CFE_MSG_PTR(TEC_LoadGen_Data.CpuAExchange.TelemetryHeader);
+    TEC_LoadGen_StreamMsg[TEC_LOADGEN_STREAM_CPUB_EXCHANGE] =
+        CFE_MSG_PTR(TEC_LoadGen_Data.CpuBExchange.TelemetryHeader);
+    TEC_LoadGen_StreamMsg[TEC_LOADGEN_STREAM_CMD]     = CFE_MSG_PTR(TEC_LoadGen_Data.TecNoop.CommandHeader);
+    TEC_LoadGen_StreamMsg[TEC_LOADGEN_STREAM_SEND_HK] = CFE_MSG_PTR(TEC_LoadGen_Data.TecSendHk.CommandHeader);
+
+    CFE_MSG_Init(CFE_MSG_PTR(TEC_LoadGen_Data.HkTlm.TelemetryHeader), CFE_SB_ValueToMsgId(TEC_LOADGEN_HK_TLM_MID),
+                 sizeof(TEC_LoadGen_Data.HkTlm));
+
+    status = CFE_SB_CreatePipe(&TEC_LoadGen_Data.CommandPipe, TEC_LOADGEN_PIPE_DEPTH, "TEC_LOADGEN_PIPE");
+    if (status == CFE_SUCCESS)
+    {
+        status = CFE_SB_Subscribe(CFE_SB_ValueToMsgId(TEC_LOADGEN_CMD_MID), TEC_LoadGen_Data.CommandPipe);
+    }
+    if (status == CFE_SUCCESS)
+    {
+        status = CFE_SB_Subscribe(CFE_SB_ValueToMsgId(TEC_LOADGEN_SEND_HK_MID), TEC_LoadGen_Data.CommandPipe);
+    }
+
+    if (status != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(TEC_LOADGEN_INIT_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "TEC LoadGen: Error creating or subscribing command pipe, RC = 0x%08lX",
+                          (unsigned long)status);
+    }
+    else
+    {
+        CFE_EVS_SendEvent(TEC_LOADGEN_INIT_INF_EID, CFE_EVS_EventType_INFORMATION,
+                          "TEC LoadGen Initialized, tick %u ms", (unsigned int)TEC_LOADGEN_TICK_MSEC);
+    }
+
+    return status;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Send the packets of one generation tick                                    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void TEC_LoadGen_Tick(void)
+{
+    const TEC_LoadGen_StreamCfg_t *Cfg;
+    uint32                         Count;
+    uint32                         Stream;
+    CFE_Status_t                   status;
+    CFE_TIME_SysTime_t             Now;
+    uint32                         Epoch;
+
+    /*
+    ** Exchange packets carry the epoch of the current time, so TEC stores
+    ** them next to its own samples instead of dropping them as late
+    */
+    Now   = CFE_TIME_GetTime();
+    Epoch = TEC_Core_EpochOf(Now.Seconds, Now.Subseconds, TEC_LoadGen_Data.Config.SamplePeriodMsec);
+    TEC_LoadGen_Data.CpuAExchange.Payload.Epoch = Epoch;
+    TEC_LoadGen_Data.CpuBExchange.Payload.Epoch = Epoch;
+
+    for (Stream = 0; Stream < TEC_LOADGEN_STREAM_COUNT; ++Stream)
+    {
+        Cfg   = &TEC_LoadGen_Data.Config.Stream[Stream];
+        Count = Cfg->PacketsPerTick;
+        if (Cfg->BurstPeriodTicks != 0 && (TEC_LoadGen_Data.HkTlm.Payload.TickCount % Cfg->BurstPeriodTicks) == 0)
+        {
+            Count += Cfg->BurstSize;
+        }
+
+        while (Count > 0)
+        {
+            status = CFE_SB_TransmitMsg(TEC_LoadGen_StreamMsg[Stream], true);
+            if (status == CFE_SUCCESS)
+            {
+                ++TEC_LoadGen_Data.HkTlm.Payload.SentCount[Stream];
+            }
+            else
+            {
+                ++TEC_LoadGen_Data.HkTlm.Payload.SendErrorCount[Stream];
+            }
+            --Count;
+        }
+    }
+
+    ++TEC_LoadGen_Data.HkTlm.Payload.TickCount;
+
+    if (TEC_LoadGen_Data.TicksLeft != 0)
+    {
+        --TEC_LoadGen_Data.TicksLeft;
+        if (TEC_LoadGen_Data.TicksLeft == 0)
+        {
+            TEC_LoadGen_Data.HkTlm.Payload.Running = false;
+            CFE_EVS_SendEvent(TEC_LOADGEN_STOP_INF_EID, CFE_EVS_EventType_INFORMATION,
+                              "TEC LoadGen: run complete after %lu ticks",
+                              (unsigned long)TEC_LoadGen_Data.HkTlm.Payload.TickCount);
+        }
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Run every tick that is due, returns the receive timeout until the next one */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static int32 TEC_LoadGen_RunDueTicks(void)
+{
+    OS_time_t Now;
+    int64     UntilNext;
+    uint32    Ticks = 0;
+
+    if (!TEC_LoadGen_Data.HkTlm.Payload.Running)
+    {
+        return CFE_SB_PEND_FOREVER;
+    }
+
+    CFE_PSP_GetTime(&Now);
+    UntilNext = OS_TimeGetTotalMilliseconds(OS_TimeSubtract(TEC_LoadGen_Data.NextTick, Now));
+
+    while (UntilNext <= 0 && TEC_LoadGen_Data.HkTlm.Payload.Running)
+    {
+        if (Ticks >= TEC_LOADGEN_MAX_CATCHUP_TICKS)
+        {
+            /* Fell too far behind, drop the missed ticks instead of bursting them */
+            TEC_LoadGen_Data.NextTick = Now;
+        }
+        else
+        {
+            TEC_LoadGen_Tick();
+            ++Ticks;
+        }
+
+        TEC_LoadGen_Data.NextTick =
+            OS_TimeAdd(TEC_LoadGen_Data.NextTick, OS_TimeFromTotalMilliseconds(TEC_LOADGEN_TICK_MSEC));
+        UntilNext = OS_TimeGetTotalMilliseconds(OS_TimeSubtract(TEC_LoadGen_Data.NextTick, Now));
+    }
+
+    if (!TEC_LoadGen_Data.HkTlm.Payload.Running)
+    {
+        return CFE_SB_PEND_FOREVER;
+    }
+
+    return (int32)UntilNext;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Verify command packet length                                               */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static bool TEC_LoadGen_VerifyCmdLength(const CFE_MSG_Message_t *MsgPtr, size_t ExpectedLength)
+{
+    size_t ActualLength = 0;
+
+    CFE_MSG_GetSize(MsgPtr, &ActualLength);
+
+    if (ExpectedLength != ActualLength)
+    {
+        CFE_EVS_SendEvent(TEC_LOADGEN_LEN_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "TEC LoadGen: Invalid Msg length: Len = %u, Expected = %u", (unsigned int)ActualLength,
+                          (unsigned int)ExpectedLength);
+
+        ++TEC_LoadGen_Data.HkTlm.Payload.CommandErrorCounter;
+        return false;
+    }
+
+    return true;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Start generating with the commanded stream shapes                          */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void TEC_LoadGen_StartCmd(const TEC_LoadGen_StartCmd_t *Msg)
+{
+    uint32 Stream;
+
+    if (Msg->Payload.SamplePeriodMsec == 0)
+    {
+        ++TEC_LoadGen_Data.HkTlm.Payload.CommandErrorCounter;
+        CFE_EVS_SendEvent(TEC_LOADGEN_START_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "TEC LoadGen: Start rejected, sample period must be non-zero");
+        return;
+    }
+
+    TEC_LoadGen_Data.Config    = Msg->Payload;
+    TEC_LoadGen_Data.TicksLeft = Msg->Payload.DurationTicks;
+
+    TEC_LoadGen_Data.CpuAExchange.Payload.Raw         = Msg->Payload.RemoteRaw;
+    TEC_LoadGen_Data.CpuAExchange.Payload.Quality     = TEC_EXCHANGE_QUALITY_VALID;
+    TEC_LoadGen_Data.CpuAExchange.Payload.ChangedMask = 0;
+    TEC_LoadGen_Data.CpuBExchange.Payload             = TEC_LoadGen_Data.CpuAExchange.Payload;
+
+    CFE_PSP_GetTime(&TEC_LoadGen_Data.NextTick);
+    TEC_LoadGen_Data.HkTlm.Payload.Running = true;
+
+    ++TEC_LoadGen_Data.HkTlm.Payload.CommandCounter;
+
+    for (Stream = 0; Stream < TEC_LOADGEN_STREAM_COUNT; ++Stream)
+    {
+        CFE_EVS_SendEvent(TEC_LOADGEN_START_INF_EID, CFE_EVS_EventType_INFORMATION,
+                          "TEC LoadGen: %s %u/tick, burst %u every %u ticks", TEC_LoadGen_StreamName[Stream],
+                          (unsigned int)Msg->Payload.Stream[Stream].PacketsPerTick,
+                          (unsigned int)Msg->Payload.Stream[Stream].BurstSize,
+                          (unsigned int)Msg->Payload.Stream[Stream].BurstPeriodTicks);
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Process ground commands                                                    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void TEC_LoadGen_ProcessGroundCommand(const CFE_SB_Buffer_t *SBBufPtr)
+{
+    CFE_MSG_FcnCode_t CommandCode = 0;
+
+    CFE_MSG_GetFcnCode(&SBBufPtr->Msg, &CommandCode);
+
+    switch (CommandCode)
+    {
+        case TEC_LOADGEN_NOOP_CC:
+            if (TEC_LoadGen_VerifyCmdLength(&SBBufPtr->Msg, sizeof(TEC_LoadGen_NoArgsCmd_t)))
+            {
+                ++TEC_LoadGen_Data.HkTlm.Payload.CommandCounter;
+                CFE_EVS_SendEvent(TEC_LOADGEN_NOOP_INF_EID, CFE_EVS_EventType_INFORMATION,
+                                  "TEC LoadGen: NOOP command");
+            }
+            break;
+
+        case TEC_LOADGEN_RESET_COUNTERS_CC:
+            if (TEC_LoadGen_VerifyCmdLength(&SBBufPtr->Msg, sizeof(TEC_LoadGen_NoArgsCmd_t)))
+            {
+                TEC_LoadGen_Data.HkTlm.Payload.CommandCounter      = 0;
+                TEC_LoadGen_Data.HkTlm.Payload.CommandErrorCounter = 0;
+                TEC_LoadGen_Data.HkTlm.Payload.TickCount           = 0;
+                memset(TEC_LoadGen_Data.HkTlm.Payload.SentCount, 0, sizeof(TEC_LoadGen_Data.HkTlm.Payload.SentCount));
+                memset(TEC_LoadGen_Data.HkTlm.Payload.SendErrorCount, 0,
+                       sizeof(TEC_LoadGen_Data.HkTlm.Payload.SendErrorCount));
+                CFE_EVS_SendEvent(TEC_LOADGEN_RESET_INF_EID, CFE_EVS_EventType_INFORMATION,
+                                  "TEC LoadGen: RESET command");
+            }
+            break;
+
+        case TEC_LOADGEN_START_CC:
+            if (TEC_LoadGen_VerifyCmdLength(&SBBufPtr->Msg, sizeof(TEC_LoadGen_StartCmd_t)))
+            {
+                TEC_LoadGen_StartCmd((const TEC_LoadGen_StartCmd_t *)SBBufPtr);
+            }
+            break;
+
+        case TEC_LOADGEN_STOP_CC:
+            if (TEC_LoadGen_VerifyCmdLength(&SBBufPtr->Msg, sizeof(TEC_LoadGen_NoArgsCmd_t)))
+            {
+                ++TEC_LoadGen_Data.HkTlm.Payload.CommandCounter;
+                TEC_LoadGen_Data.HkTlm.Payload.Running = false;
+                CFE_EVS_SendEvent(TEC_LOADGEN_STOP_INF_EID, CFE_EVS_EventType_INFORMATION,
+                                  "TEC LoadGen: stopped after %lu ticks",
+                                  (unsigned long)TEC_LoadGen_Data.HkTlm.Payload.TickCount);
+            }
+            break;
+
+        default:
+            ++TEC_LoadGen_Data.HkTlm.Payload.CommandErrorCounter;
+            CFE_EVS_SendEvent(TEC_LOADGEN_CC_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "TEC LoadGen: Invalid ground command code: CC = %d", CommandCode);
+            break;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Process packets received on the command pipe                               */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void TEC_LoadGen_TaskPipe(const CFE_SB_Buffer_t *SBBufPtr)
+{
+    CFE_SB_MsgId_t MsgId = CFE_SB_INVALID_MSG_ID;
+
+    CFE_MSG_GetMsgId(&SBBufPtr->Msg, &MsgId);
+
+    switch (CFE_SB_MsgIdToValue(MsgId))
+    {
+        case TEC_LOADGEN_CMD_MID:
+            TEC_LoadGen_ProcessGroundCommand(SBBufPtr);
+            break;
+
+        case TEC_LOADGEN_SEND_HK_MID:
+            CFE_SB_TimeStampMsg(CFE_MSG_PTR(TEC_LoadGen_Data.HkTlm.TelemetryHeader));
+            CFE_SB_TransmitMsg(CFE_MSG_PTR(TEC_LoadGen_Data.HkTlm.TelemetryHeader), true);
+            break;
+
+        default:
+            CFE_EVS_SendEvent(TEC_LOADGEN_MID_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "TEC LoadGen: invalid command packet,MID = 0x%x",
+                              (unsigned int)CFE_SB_MsgIdToValue(MsgId));
+            break;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Application entry point and main process loop                              */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void TEC_LoadGen_Main(void)
+{
+    CFE_Status_t     status;
+    CFE_SB_Buffer_t *SBBufPtr;
+    int32            Timeout = CFE_SB_PEND_FOREVER;
+
+    status = TEC_LoadGen_Init();
+    if (status != CFE_SUCCESS)
+    {
+        TEC_LoadGen_Data.RunStatus = CFE_ES_RunStatus_APP_ERROR;
+    }
+
+    while (CFE_ES_RunLoop(&TEC_LoadGen_Data.RunStatus) == true)
+    {
+        /* Pend on commands until the next generation tick is due */
+        status = CFE_SB_ReceiveBuffer(&SBBufPtr, TEC_LoadGen_Data.CommandPipe, Timeout);
+
+        if (status == CFE_SUCCESS)
+        {
+            TEC_LoadGen_TaskPipe(SBBufPtr);
+        }
+        else if (status != CFE_SB_TIME_OUT && status != CFE_SB_NO_MESSAGE)
+        {
+            CFE_EVS_SendEvent(TEC_LOADGEN_PIPE_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "TEC LoadGen: SB Pipe Read Error, App Will Exit");
+
+            TEC_LoadGen_Data.RunStatus = CFE_ES_RunStatus_APP_ERROR;
+        }
+
+        Timeout = TEC_LoadGen_RunDueTicks();
+    }
+
+    CFE_ES_ExitApp(TEC_LoadGen_Data.RunStatus);
+}
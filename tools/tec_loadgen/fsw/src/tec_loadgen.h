@@ -0,0 +1,172 @@
+/************************************************************************
+ * NASA Docket No. GSC-18,719-1, and identified as “core Flight System: Bootes”
+ *
+ * Copyright (c) 2020 United States Government as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ************************************************************************/
+
+/**
+ * @file
+ *
+ * Main header file for the TEC load generator test application
+ *
+ * TEC_LOADGEN publishes synthetic CPU A/B exchange packets, TEC ground
+ * commands and TEC housekeeping requests at commanded rates and burst
+ * shapes so the saturation point of the TEC command pipe can be measured.
+ * It is a test tool and must not be part of a flight build.
+ */
+
+#ifndef TEC_LOADGEN_H
+#define TEC_LOADGEN_H
+
+/*
+** Required header files.
+*/
+#include "cfe.h"
+
+#include "tec_msgids.h"
+#include "tec_loadgen_topicids.h"
+#include "tec_msg.h"
+
+/************************************************************************
+** Macro Definitions
+*************************************************************************/
+
+#define TEC_LOADGEN_CMD_MID     CFE_PLATFORM_CMD_TOPICID_TO_MIDV(CFE_MISSION_TEC_LOADGEN_CMD_TOPICID) /* 0x189E */
+#define TEC_LOADGEN_SEND_HK_MID CFE_PLATFORM_CMD_TOPICID_TO_MIDV(CFE_MISSION_TEC_LOADGEN_SEND_HK_TOPICID) /* 0x189F */
+#define TEC_LOADGEN_HK_TLM_MID  CFE_PLATFORM_TLM_TOPICID_TO_MIDV(CFE_MISSION_TEC_LOADGEN_HK_TLM_TOPICID) /* 0x089F */
+
+#define TEC_LOADGEN_PIPE_DEPTH 8
+#define TEC_LOADGEN_TICK_MSEC  10 /* Generation tick */
+#define TEC_LOADGEN_MAX_CATCHUP_TICKS 10 /* Ticks replayed at most after a late wakeup */
+
+/*
+** Command codes
+*/
+#define TEC_LOADGEN_NOOP_CC           0
+#define TEC_LOADGEN_RESET_COUNTERS_CC 1
+#define TEC_LOADGEN_START_CC          2
+#define TEC_LOADGEN_STOP_CC           3
+
+/*
+** Generated streams
+*/
+#define TEC_LOADGEN_STREAM_CPUA_EXCHANGE 0 /**< Synthetic CPUA_EXCHANGE_MID packets */
+#define TEC_LOADGEN_STREAM_CPUB_EXCHANGE 1 /**< Synthetic CPUB_EXCHANGE_MID packets */
+#define TEC_LOADGEN_STREAM_CMD           2 /**< TEC_NOOP_CC ground commands */
+#define TEC_LOADGEN_STREAM_SEND_HK       3 /**< TEC_SEND_HK_MID requests */
+#define TEC_LOADGEN_STREAM_COUNT         4
+
+/*
+** Event IDs
+*/
+#define TEC_LOADGEN_INIT_INF_EID  1
+#define TEC_LOADGEN_CC_ERR_EID    2
+#define TEC_LOADGEN_NOOP_INF_EID  3
+#define TEC_LOADGEN_RESET_INF_EID 4
+#define TEC_LOADGEN_MID_ERR_EID   5
+#define TEC_LOADGEN_LEN_ERR_EID   6
+#define TEC_LOADGEN_PIPE_ERR_EID  7
+#define TEC_LOADGEN_START_INF_EID 8
+#define TEC_LOADGEN_STOP_INF_EID  9
+#define TEC_LOADGEN_INIT_ERR_EID  10
+#define TEC_LOADGEN_START_ERR_EID 11
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+/**
+ * \brief Shape of one generated stream
+ *
+ * Every tick the stream sends PacketsPerTick packets. Every BurstPeriodTicks
+ * ticks (0 = never) it sends BurstSize additional packets back to back.
+ */
+typedef struct
+{
+    uint16 PacketsPerTick;
+    uint16 BurstSize;
+    uint16 BurstPeriodTicks;
+    uint16 Spare;
+} TEC_LoadGen_StreamCfg_t;
+
+typedef struct
+{
+    TEC_LoadGen_StreamCfg_t Stream[TEC_LOADGEN_STREAM_COUNT];
+    uint32                  DurationTicks;    /**< Stop after this many ticks, 0 = until STOP */
+    uint32                  RemoteRaw;        /**< Raw sample carried in the synthetic exchange packets */
+    uint32                  SamplePeriodMsec; /**< SamplePeriodMsec of the TEC configuration table, sets the epoch */
+} TEC_LoadGen_Start_Payload_t;
+
+typedef struct
+{
+    uint8  CommandCounter;
+    uint8  CommandErrorCounter;
+    uint8  Running;
+    uint8  Spare;
+    uint32 TickCount;
+    uint32 SentCount[TEC_LOADGEN_STREAM_COUNT];      /**< Packets accepted by CFE_SB_TransmitMsg */
+    uint32 SendErrorCount[TEC_LOADGEN_STREAM_COUNT]; /**< Packets rejected by CFE_SB_TransmitMsg */
+} TEC_LoadGen_HkTlm_Payload_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CommandHeader; /**< \brief Command header */
+} TEC_LoadGen_NoArgsCmd_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t     CommandHeader; /**< \brief Command header */
+    TEC_LoadGen_Start_Payload_t Payload;
+} TEC_LoadGen_StartCmd_t;
+
+typedef struct
+{
+    CFE_MSG_TelemetryHeader_t   TelemetryHeader; /**< \brief Telemetry header */
+    TEC_LoadGen_HkTlm_Payload_t Payload;
+} TEC_LoadGen_HkTlm_t;
+
+/*
+** Global Data
+*/
+typedef struct
+{
+    uint32 RunStatus;
+
+    CFE_SB_PipeId_t CommandPipe;
+
+    TEC_LoadGen_Start_Payload_t Config;
+    uint32                      TicksLeft;
+    OS_time_t                   NextTick;
+
+    /*
+    ** Generated packets, initialized once and re-sent
+    */
+    TEC_ExchangeTlm_t CpuAExchange;
+    TEC_ExchangeTlm_t CpuBExchange;
+    TEC_NoopCmd_t     TecNoop;
+    TEC_SendHkCmd_t   TecSendHk;
+
+    TEC_LoadGen_HkTlm_t HkTlm;
+} TEC_LoadGen_Data_t;
+
+extern TEC_LoadGen_Data_t TEC_LoadGen_Data;
+
+/****************************************************************************/
+/*
+** Function prototypes.
+*/
+void TEC_LoadGen_Main(void);
+
+#endif /* TEC_LOADGEN_H */